@@ -19,37 +19,71 @@
 INCLUDEPATH += $$PWD\..\Include
 
 HEADERS += \
+    $$PWD/batchgrader.h \
+    $$PWD/boardspec.h \
     $$PWD/classes.h \
     $$PWD/deserializer.h \
+    $$PWD/discontinuitylocator.h \
     $$PWD/diskrepository.h \
     $$PWD/dot.h \
     $$PWD/dotgenerator.h \
+    $$PWD/dotgrid.h \
+    $$PWD/dotset.h \
+    $$PWD/emptydotgenerator.h \
     $$PWD/evaluator.h \
     $$PWD/functions.h \
     $$PWD/expression.h \
     $$PWD/basex.h \
+    $$PWD/cancellationtoken.h \
     $$PWD/constant.h \
     $$PWD/game.h \
+    $$PWD/gameslot.h \
+    $$PWD/gamesnapshot.h \
+    $$PWD/graphdecimator.h \
+    $$PWD/graphtilecache.h \
+    $$PWD/hitscore.h \
     $$PWD/mathhelper.h \
     $$PWD/parser.h \
     $$PWD/power.h \
+    $$PWD/prefetchingdotgenerator.h \
     $$PWD/product.h \
+    $$PWD/progressiveevaluator.h \
     $$PWD/randomdotgenerator.h \
     $$PWD/repository.h \
-    $$PWD/sum.h
+    $$PWD/sessionmanager.h \
+    $$PWD/sum.h \
+    $$PWD/threadpool.h \
+    $$PWD/updatescheduler.h
 
 SOURCES += \
+    $$PWD/batchgrader.cpp \
+    $$PWD/boardspec.cpp \
     $$PWD/deserializer.cpp \
+    $$PWD/discontinuitylocator.cpp \
     $$PWD/diskrepository.cpp \
     $$PWD/dot.cpp \
+    $$PWD/dotgrid.cpp \
+    $$PWD/dotset.cpp \
+    $$PWD/emptydotgenerator.cpp \
     $$PWD/evaluator.cpp \
     $$PWD/functions.cpp \
     $$PWD/basex.cpp \
+    $$PWD/cancellationtoken.cpp \
     $$PWD/constant.cpp \
     $$PWD/game.cpp \
+    $$PWD/gameslot.cpp \
+    $$PWD/gamesnapshot.cpp \
+    $$PWD/graphdecimator.cpp \
+    $$PWD/graphtilecache.cpp \
+    $$PWD/hitscore.cpp \
     $$PWD/mathhelper.cpp \
     $$PWD/parser.cpp \
     $$PWD/power.cpp \
+    $$PWD/prefetchingdotgenerator.cpp \
     $$PWD/product.cpp \
+    $$PWD/progressiveevaluator.cpp \
     $$PWD/randomdotgenerator.cpp \
-    $$PWD/sum.cpp
+    $$PWD/sessionmanager.cpp \
+    $$PWD/sum.cpp \
+    $$PWD/threadpool.cpp \
+    $$PWD/updatescheduler.cpp
@@ -0,0 +1,332 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "batchgrader.h"
+#include "emptydotgenerator.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <sstream>
+#include <iomanip>
+
+namespace Backend {
+
+    namespace
+    {
+        double GetMillisecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::wstring QuoteForCsv(const std::wstring & value)
+        {
+            std::wstring quoted(L"\"");
+            for(auto character : value)
+            {
+                if(character == L'"')
+                {
+                    quoted.push_back(L'"');
+                }
+                quoted.push_back(character);
+            }
+            quoted.push_back(L'"');
+
+            return quoted;
+        }
+    }
+
+    BatchGrader::BatchGrader(std::shared_ptr<Repository> repository, unsigned int threadCount, unsigned long int functionLimit)
+        : repository(repository),
+          // the loaded game replaces the dots, and the tasks share the generator, so it must not hold state
+          dotGenerator(std::make_shared<EmptyDotGenerator>()),
+          threadPool(std::make_shared<ThreadPool>(threadCount)),
+          functionLimit(functionLimit)
+    {
+        if(functionLimit == 0)
+        {
+            throw std::exception("a game needs to allow functions");
+        }
+    }
+
+    BatchGrader::Summary BatchGrader::Grade(const std::vector<std::wstring> & identifiers, const std::function<void(const Result&)> & consume, const std::function<void(const Summary&)> & progress, std::shared_ptr<CancellationToken> cancellationToken)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Summary summary { 0, 0, 0.0, 0.0 };
+
+        // results wait in a ring until all earlier ones are passed on, and no game is started further ahead than the ring holds
+        const size_t windowSize = this->threadPool->GetThreadCount() * BatchGrader::WindowSizePerThread;
+        std::vector<Result> window(windowSize);
+        std::vector<bool> isGraded(windowSize, false);
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t nextToGrade = 0;
+        size_t nextToConsume = 0;
+        bool isStopping = false;
+        bool isDone = false;
+        std::exception_ptr gradingException;
+
+        auto gradeAll = [&](size_t)
+        {
+            while(true)
+            {
+                size_t index;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]{ return isStopping || nextToGrade >= identifiers.size() || nextToGrade < nextToConsume + windowSize; });
+
+                    if(isStopping || nextToGrade >= identifiers.size() || (cancellationToken && cancellationToken->IsCancelled()))
+                    {
+                        return;
+                    }
+
+                    index = nextToGrade++;
+                }
+
+                auto result = this->GradeOne(identifiers[index]);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    window[index % windowSize] = std::move(result);
+                    isGraded[index % windowSize] = true;
+                }
+
+                changed.notify_all();
+            }
+        };
+
+        // each game evaluates on a single thread, the pool spreads the games across the cores and the calling thread passes on the results
+        std::thread grading([&]()
+        {
+            try
+            {
+                this->threadPool->ForEach(this->threadPool->GetThreadCount(), gradeAll);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                gradingException = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isDone = true;
+            }
+
+            changed.notify_all();
+        });
+
+        try
+        {
+            while(true)
+            {
+                Result result;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]{ return isDone || isGraded[nextToConsume % windowSize]; });
+
+                    // games taken are always finished, so a gap once grading is done means it stopped early
+                    if(!isGraded[nextToConsume % windowSize])
+                    {
+                        break;
+                    }
+
+                    result = std::move(window[nextToConsume % windowSize]);
+                    isGraded[nextToConsume % windowSize] = false;
+                    ++nextToConsume;
+                }
+
+                changed.notify_all();
+                consume(result);
+
+                ++summary.gradedCount;
+                if(!result.isLoaded)
+                {
+                    ++summary.failedCount;
+                }
+
+                if(progress && summary.gradedCount % windowSize == 0)
+                {
+                    summary.milliseconds = GetMillisecondsSince(start);
+                    summary.gamesPerSecond = summary.milliseconds > 0.0 ? 1000.0 * summary.gradedCount / summary.milliseconds : 0.0;
+                    progress(summary);
+                }
+            }
+        }
+        catch(...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isStopping = true;
+            }
+
+            changed.notify_all();
+            grading.join();
+            throw;
+        }
+
+        grading.join();
+
+        if(gradingException)
+        {
+            std::rethrow_exception(gradingException);
+        }
+
+        summary.milliseconds = GetMillisecondsSince(start);
+        summary.gamesPerSecond = summary.milliseconds > 0.0 ? 1000.0 * summary.gradedCount / summary.milliseconds : 0.0;
+
+        if(progress && summary.gradedCount % windowSize != 0)
+        {
+            progress(summary);
+        }
+
+        return summary;
+    }
+
+    BatchGrader::Result BatchGrader::GradeOne(const std::wstring & identifier) const
+    {
+        auto start = std::chrono::steady_clock::now();
+        Result result { identifier, false, L"", 0, std::vector<Dot>(), 0.0 };
+
+        try
+        {
+            Game game(this->dotGenerator, this->repository, 1, this->functionLimit);
+
+            // loading evaluates the functions, too
+            auto loadResult = game.Load(identifier);
+            result.isLoaded = loadResult.first;
+            result.error = loadResult.second;
+
+            if(result.isLoaded)
+            {
+                result.score = game.GetScore();
+
+                for(const auto & dot : game.GetDots())
+                {
+                    result.dots.push_back(*dot);
+                }
+            }
+        }
+        catch(const std::exception&)
+        {
+            result.isLoaded = false;
+            result.error = std::wstring(L"exception when grading: ") + identifier;
+        }
+
+        result.milliseconds = GetMillisecondsSince(start);
+
+        return result;
+    }
+
+    unsigned int BatchGrader::GetThreadCount() const
+    {
+        return this->threadPool->GetThreadCount();
+    }
+
+    /* static class member */ std::wstring BatchGrader::GetCsvHeader()
+    {
+        return L"file,loaded,score,goodHit,goodCount,badHit,badCount,milliseconds,dots,error";
+    }
+
+    /* static class member */ std::wstring BatchGrader::FormatAsCsv(const Result & result)
+    {
+        unsigned int goodHit = 0;
+        unsigned int goodCount = 0;
+        unsigned int badHit = 0;
+        unsigned int badCount = 0;
+        std::wstring dots;
+
+        for(const auto & dot : result.dots)
+        {
+            if(dot.IsGood())
+            {
+                ++goodCount;
+                goodHit += dot.IsActive() ? 1 : 0;
+                dots.push_back(dot.IsActive() ? L'G' : L'g');
+            }
+            else
+            {
+                ++badCount;
+                badHit += dot.IsActive() ? 1 : 0;
+                dots.push_back(dot.IsActive() ? L'B' : L'b');
+            }
+        }
+
+        std::wostringstream line;
+        line << QuoteForCsv(result.identifier) << L','
+             << (result.isLoaded ? 1 : 0) << L','
+             << result.score << L','
+             << goodHit << L','
+             << goodCount << L','
+             << badHit << L','
+             << badCount << L','
+             << std::fixed << std::setprecision(3) << result.milliseconds << L','
+             << dots << L','
+             << QuoteForCsv(result.error);
+
+        return line.str();
+    }
+
+    /* static class member */ std::wstring BatchGrader::FormatAsJson(const Result & result)
+    {
+        rapidjson::GenericStringBuffer<rapidjson::UTF16<wchar_t>> buffer;
+        rapidjson::Writer<rapidjson::GenericStringBuffer<rapidjson::UTF16<wchar_t>>, rapidjson::UTF16<wchar_t>, rapidjson::UTF16<wchar_t>> writer(buffer);
+
+        writer.StartObject();
+        writer.Key(L"file");
+        writer.String(result.identifier.c_str(), static_cast<rapidjson::SizeType>(result.identifier.size()));
+        writer.Key(L"loaded");
+        writer.Bool(result.isLoaded);
+        writer.Key(L"score");
+        writer.Int(result.score);
+        writer.Key(L"milliseconds");
+        writer.Double(result.milliseconds);
+        writer.Key(L"dots");
+        writer.StartArray();
+        for(const auto & dot : result.dots)
+        {
+            auto coordinates = dot.GetCoordinates();
+
+            writer.StartObject();
+            writer.Key(L"x");
+            writer.Double(coordinates.first);
+            writer.Key(L"y");
+            writer.Double(coordinates.second);
+            writer.Key(L"good");
+            writer.Bool(dot.IsGood());
+            writer.Key(L"hit");
+            writer.Bool(dot.IsActive());
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.Key(L"error");
+        writer.String(result.error.c_str(), static_cast<rapidjson::SizeType>(result.error.size()));
+        writer.EndObject();
+
+        return std::wstring(buffer.GetString());
+    }
+
+}
@@ -0,0 +1,148 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BATCHGRADER_H
+#define BATCHGRADER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include "classes.h"
+#include "dot.h"
+#include "game.h"
+#include "repository.h"
+#include "diskrepository.h"
+#include "threadpool.h"
+#include "cancellationtoken.h"
+
+namespace Backend {
+
+    /*!
+     * \class BatchGrader
+     * \brief The BatchGrader class loads and scores many saved games on a pool of threads without a user interface.
+     *
+     * Each thread takes the next game as soon as it is done with its last one, but only within a window ahead of the oldest result
+     * not yet passed on, so only a few results are held in memory at once regardless of the size of the batch.
+     */
+    class BatchGrader final
+    {
+    public:
+        /*!
+         * \brief The Result struct describes the outcome of grading one saved game.
+         */
+        struct Result
+        {
+            std::wstring identifier;
+            bool isLoaded;
+            std::wstring error;
+            int score;
+            std::vector<Dot> dots;
+            double milliseconds;
+        };
+
+        /*!
+         * \brief The Summary struct describes the progress of a batch.
+         */
+        struct Summary
+        {
+            size_t gradedCount;
+            size_t failedCount;
+            double milliseconds;
+            double gamesPerSecond;
+        };
+
+    private:
+        /*!
+         * \brief WindowSizePerThread is the number of games per thread that may be graded ahead of the oldest result not yet passed on.
+         */
+        constexpr static const size_t WindowSizePerThread = 4;
+
+        std::shared_ptr<Repository> repository;
+        std::shared_ptr<DotGenerator> dotGenerator;
+        std::shared_ptr<ThreadPool> threadPool;
+        unsigned long int functionLimit;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param repository The repository to load the games from, which must allow concurrent loading.
+         * \param threadCount The number of threads grading games, 0 meaning one per core.
+         * \param functionLimit The number of functions evaluated per game, further ones are ignored.
+         */
+        BatchGrader(std::shared_ptr<Repository> repository = std::make_shared<DiskRepository>(),
+                    unsigned int threadCount = 0,
+                    unsigned long int functionLimit = Game::DefaultFunctionLimit);
+        ~BatchGrader() = default;
+        BatchGrader(const BatchGrader&) = delete;
+        BatchGrader(BatchGrader&&) = delete;
+        BatchGrader& operator=(const BatchGrader&) = delete;
+        BatchGrader& operator=(BatchGrader&&) = delete;
+
+        /*!
+         * \brief Grade loads and scores the games, passing on each result in the order of the identifiers.
+         * \param identifiers The identifiers of the saved games, e.g. file paths.
+         * \param consume The function accepting each result, called on the calling thread.
+         * \param progress The optional function accepting the summary so far after each window of results and at the end, called on the calling thread.
+         * \param cancellationToken The optional token to stop grading once the games already started are finished.
+         * \return The summary of the games graded.
+         */
+        Summary Grade(const std::vector<std::wstring> & identifiers,
+                      const std::function<void(const Result&)> & consume,
+                      const std::function<void(const Summary&)> & progress = nullptr,
+                      std::shared_ptr<CancellationToken> cancellationToken = nullptr);
+
+        /*!
+         * \brief GradeOne loads and scores a single game on the calling thread.
+         * \param identifier The identifier of the saved game.
+         * \return The result, which reports an error instead of throwing.
+         */
+        Result GradeOne(const std::wstring & identifier) const;
+
+        /*!
+         * \brief GetThreadCount gets the number of threads grading games.
+         * \return The count.
+         */
+        unsigned int GetThreadCount() const;
+
+        /*!
+         * \brief GetCsvHeader gets the header line matching \ref FormatAsCsv.
+         * \return The header without a line break.
+         */
+        static std::wstring GetCsvHeader();
+
+        /*!
+         * \brief FormatAsCsv formats a result as a line of comma-separated values.
+         *
+         * The dots are one letter each in the order of the game, uppercase if hit: G/g for good dots, B/b for bad ones.
+         * \param result The result to format.
+         * \return The line without a line break.
+         */
+        static std::wstring FormatAsCsv(const Result & result);
+
+        /*!
+         * \brief FormatAsJson formats a result as a single-line JSON object.
+         * \param result The result to format.
+         * \return The line without a line break.
+         */
+        static std::wstring FormatAsJson(const Result & result);
+    };
+
+}
+
+#endif // BATCHGRADER_H
@@ -0,0 +1,119 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "boardspec.h"
+
+namespace Backend {
+
+    BoardSpec::BoardSpec(unsigned int goodDots, unsigned int badDots, double extent, unsigned int latticeLines, double latticeSpacing, double minRadius, double maxRadius, double limit)
+        : goodDots(goodDots),
+          badDots(badDots),
+          extent(extent),
+          latticeLines(latticeLines),
+          latticeSpacing(latticeSpacing),
+          minRadius(minRadius),
+          maxRadius(maxRadius),
+          limit(limit)
+    {
+        if(!(extent > 0.0))
+        {
+            throw std::exception("extent of a board must be positive");
+        }
+
+        if(!(latticeSpacing > 0.0))
+        {
+            throw std::exception("lattice spacing of a board must be positive");
+        }
+
+        if(static_cast<unsigned long long>(goodDots) + badDots > static_cast<unsigned long long>(latticeLines) * latticeLines)
+        {
+            throw std::exception("lattice of a board must offer a point per dot");
+        }
+
+        if(minRadius < 0.0 || maxRadius < minRadius)
+        {
+            throw std::exception("radii of the dots must be ordered and not negative");
+        }
+
+        if(!(limit > extent))
+        {
+            throw std::exception("limit of a board must exceed its extent");
+        }
+    }
+
+    unsigned int BoardSpec::GetGoodDots() const
+    {
+        return this->goodDots;
+    }
+
+    unsigned int BoardSpec::GetBadDots() const
+    {
+        return this->badDots;
+    }
+
+    double BoardSpec::GetExtent() const
+    {
+        return this->extent;
+    }
+
+    double BoardSpec::GetMinX() const
+    {
+        return -this->extent;
+    }
+
+    double BoardSpec::GetMaxX() const
+    {
+        return this->extent;
+    }
+
+    unsigned int BoardSpec::GetLatticeLines() const
+    {
+        return this->latticeLines;
+    }
+
+    double BoardSpec::GetLatticeSpacing() const
+    {
+        return this->latticeSpacing;
+    }
+
+    double BoardSpec::GetLatticeOrigin() const
+    {
+        return -0.5 * (static_cast<double>(this->latticeLines) - 1.0) * this->latticeSpacing;
+    }
+
+    double BoardSpec::GetMaxOffset() const
+    {
+        return 0.15 * this->latticeSpacing;
+    }
+
+    double BoardSpec::GetMinRadius() const
+    {
+        return this->minRadius;
+    }
+
+    double BoardSpec::GetMaxRadius() const
+    {
+        return this->maxRadius;
+    }
+
+    double BoardSpec::GetLimit() const
+    {
+        return this->limit;
+    }
+
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BOARDSPEC_H
+#define BOARDSPEC_H
+
+namespace Backend {
+
+    /*!
+     * \class BoardSpec
+     * \brief The BoardSpec class describes the geometry of a board: the window the graphs are evaluated in
+     *        and the lattice the dots are placed on.
+     *
+     * The lattice is square, centered on the origin and has \ref GetLatticeLines lines in either direction.
+     * Each dot is offset from its lattice point by a small random amount and has a radius drawn uniformly
+     * from [\ref GetMinRadius, \ref GetMaxRadius].
+     */
+    class BoardSpec final
+    {
+    private:
+        unsigned int goodDots;
+        unsigned int badDots;
+        double extent;
+        unsigned int latticeLines;
+        double latticeSpacing;
+        double minRadius;
+        double maxRadius;
+        double limit;
+
+    public:
+        /*!
+         * \brief Initializes a new instance, the defaults describing the classic board.
+         * \param goodDots The number of good dots.
+         * \param badDots The number of bad dots.
+         * \param extent The half-width of the window, which reaches from -extent to extent in x and y.
+         * \param latticeLines The number of lattice lines in either direction, which must offer a point per dot.
+         * \param latticeSpacing The distance between neighboring lattice lines, which must be positive.
+         * \param minRadius The smallest radius of a dot, which must not be negative.
+         * \param maxRadius The largest radius of a dot, which must not be smaller than \a minRadius.
+         * \param limit The absolute value of y beyond which a graph is not evaluated any further, which must exceed \a extent.
+         */
+        BoardSpec(unsigned int goodDots = 8,
+                  unsigned int badDots = 2,
+                  double extent = 10.5,
+                  unsigned int latticeLines = 19,
+                  double latticeSpacing = 1.0,
+                  double minRadius = 0.25,
+                  double maxRadius = 0.25,
+                  double limit = 1000.0);
+        ~BoardSpec() = default;
+        BoardSpec(const BoardSpec&) = default;
+        BoardSpec(BoardSpec&&) = default;
+        BoardSpec& operator=(const BoardSpec&) = default;
+        BoardSpec& operator=(BoardSpec&&) = default;
+
+        /*!
+         * \brief Gets the number of good dots.
+         * \return The count.
+         */
+        unsigned int GetGoodDots() const;
+
+        /*!
+         * \brief Gets the number of bad dots.
+         * \return The count.
+         */
+        unsigned int GetBadDots() const;
+
+        /*!
+         * \brief Gets the half-width of the window.
+         * \return The extent in graph units.
+         */
+        double GetExtent() const;
+
+        /*!
+         * \brief Gets the smallest x of the window.
+         * \return The negative extent.
+         */
+        double GetMinX() const;
+
+        /*!
+         * \brief Gets the largest x of the window.
+         * \return The extent.
+         */
+        double GetMaxX() const;
+
+        /*!
+         * \brief Gets the number of lattice lines in either direction.
+         * \return The count.
+         */
+        unsigned int GetLatticeLines() const;
+
+        /*!
+         * \brief Gets the distance between neighboring lattice lines.
+         * \return The spacing in graph units.
+         */
+        double GetLatticeSpacing() const;
+
+        /*!
+         * \brief Gets the coordinate of the first lattice line, in x as well as in y.
+         * \return The coordinate, chosen such that the lattice is centered on the origin.
+         */
+        double GetLatticeOrigin() const;
+
+        /*!
+         * \brief Gets the largest offset of a dot from its lattice point, in x as well as in y.
+         * \return The offset in graph units.
+         */
+        double GetMaxOffset() const;
+
+        /*!
+         * \brief Gets the smallest radius of a dot.
+         * \return The radius in graph units.
+         */
+        double GetMinRadius() const;
+
+        /*!
+         * \brief Gets the largest radius of a dot.
+         * \return The radius in graph units.
+         */
+        double GetMaxRadius() const;
+
+        /*!
+         * \brief Gets the absolute value of y beyond which a graph is not evaluated any further.
+         * \return The limit.
+         */
+        double GetLimit() const;
+    };
+
+}
+
+#endif // BOARDSPEC_H
@@ -0,0 +1,52 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cancellationtoken.h"
+
+namespace Backend {
+
+    CancellationToken::CancellationToken()
+        : isCancelled(false),
+          hasDeadline(false),
+          deadline()
+    {
+    }
+
+    CancellationToken::CancellationToken(std::chrono::milliseconds budget)
+        : isCancelled(false),
+          hasDeadline(true),
+          deadline(std::chrono::steady_clock::now() + budget)
+    {
+    }
+
+    void CancellationToken::Cancel()
+    {
+        this->isCancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool CancellationToken::IsCancelled() const
+    {
+        if(this->isCancelled.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        return this->hasDeadline && std::chrono::steady_clock::now() >= this->deadline;
+    }
+
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <atomic>
+#include <chrono>
+
+namespace Backend {
+
+    /*!
+     * \class CancellationToken
+     * \brief The CancellationToken class allows long-running work to be stopped cooperatively,
+     *        either on request or when a wall-clock deadline has passed.
+     *
+     * The token may be cancelled from any thread, while the work polls \ref IsCancelled at loop granularity.
+     */
+    class CancellationToken final
+    {
+    private:
+        std::atomic<bool> isCancelled;
+        const bool hasDeadline;
+        const std::chrono::steady_clock::time_point deadline;
+
+    public:
+        /*!
+         * \brief Initializes a new instance without a deadline.
+         */
+        CancellationToken();
+
+        /*!
+         * \brief Initializes a new instance that is cancelled once the budget, starting now, is used up.
+         * \param budget The wall-clock time the work may take.
+         */
+        explicit CancellationToken(std::chrono::milliseconds budget);
+        ~CancellationToken() = default;
+        CancellationToken(const CancellationToken&) = delete;
+        CancellationToken(CancellationToken&&) = delete;
+        CancellationToken& operator=(const CancellationToken&) = delete;
+        CancellationToken& operator=(CancellationToken&&) = delete;
+
+        /*!
+         * \brief Cancel requests the work to stop.
+         */
+        void Cancel();
+
+        /*!
+         * \brief IsCancelled indicates whether the work shall stop.
+         * \return true if cancellation was requested or the deadline has passed.
+         */
+        bool IsCancelled() const;
+    };
+
+}
+
+#endif // CANCELLATIONTOKEN_H
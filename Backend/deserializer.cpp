@@ -238,12 +238,12 @@ namespace Backend
             deserializedFunctions.push_back(deserializedFunction);
         }
 
-        while(deserializedFunctions.size() > 5)
+        while(deserializedFunctions.size() > game.GetFunctionLimit())
         {
             deserializedFunctions.pop_back();
         }
 
-        while(deserializedFunctions.size() < 5)
+        while(deserializedFunctions.size() < game.GetFunctionLimit())
         {
             deserializedFunctions.push_back(L"");
         }
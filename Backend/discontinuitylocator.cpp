@@ -0,0 +1,155 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include "discontinuitylocator.h"
+
+namespace Backend {
+
+    DiscontinuityLocator::DiscontinuityLocator(std::shared_ptr<Expression> expression, double limit, double precision)
+        : expression(expression),
+          limit(limit),
+          precision(precision)
+    {
+    }
+
+    bool DiscontinuityLocator::IsInside(double x) const
+    {
+        auto yOptional = this->expression->Evaluate(x);
+        return yOptional.has_value() && std::abs(yOptional.value()) <= this->limit;
+    }
+
+    std::optional<DiscontinuityLocator::Boundary> DiscontinuityLocator::FindInsideAfter(double from, double to, double step) const
+    {
+        double outside = from;
+        double x = from;
+
+        while (x < to)
+        {
+            x += step;
+
+            auto yOptional = this->expression->Evaluate(x);
+            if(yOptional.has_value() && std::abs(yOptional.value()) <= this->limit)
+            {
+                auto edge = this->LocateEdge(x, outside);
+
+                // the kind is decided just outside the edge
+                auto outsideOptional = this->expression->Evaluate(edge - this->precision);
+                auto kind = outsideOptional.has_value() ? Kind::Limit : Kind::DomainEdge;
+
+                return Boundary{edge, kind};
+            }
+
+            outside = x;
+        }
+
+        return std::nullopt;
+    }
+
+    double DiscontinuityLocator::LocateEdge(double inside, double outside) const
+    {
+        while (std::abs(outside - inside) > this->precision)
+        {
+            double mid = 0.5 * (inside + outside);
+
+            // far from zero, adjacent doubles can be further apart than the precision
+            if(mid == inside || mid == outside)
+            {
+                break;
+            }
+
+            if(this->IsInside(mid))
+            {
+                inside = mid;
+            }
+            else
+            {
+                outside = mid;
+            }
+        }
+
+        return inside;
+    }
+
+    bool DiscontinuityLocator::IsPoleBetween(double x1, double y1, double x2, double y2) const
+    {
+        if((y1 < 0.0) == (y2 < 0.0))
+        {
+            return false;
+        }
+
+        auto midOptional = this->expression->Evaluate(0.5 * (x1 + x2));
+        if(!midOptional.has_value())
+        {
+            return true;
+        }
+
+        // between a zero and an end, a monotonic function stays below the value at that end, a pole grows beyond it
+        double yMid = midOptional.value();
+        double ySameSign = (yMid < 0.0) == (y1 < 0.0) ? y1 : y2;
+        return std::abs(yMid) > std::abs(ySameSign);
+    }
+
+    std::optional<double> DiscontinuityLocator::LocatePole(double x1, double y1, double x2, double y2) const
+    {
+        if(!this->IsPoleBetween(x1, y1, x2, y2))
+        {
+            return std::nullopt;
+        }
+
+        // keep the half with the sign change, which closes in on the pole
+        while (std::abs(x2 - x1) > this->precision)
+        {
+            double mid = 0.5 * (x1 + x2);
+
+            // far from zero, adjacent doubles can be further apart than the precision
+            if(mid == x1 || mid == x2)
+            {
+                break;
+            }
+
+            auto midOptional = this->expression->Evaluate(mid);
+
+            if(!midOptional.has_value())
+            {
+                return mid;
+            }
+
+            double yMid = midOptional.value();
+            if((yMid < 0.0) == (y1 < 0.0))
+            {
+                x1 = mid;
+                y1 = yMid;
+            }
+            else
+            {
+                x2 = mid;
+                y2 = yMid;
+            }
+        }
+
+        // a zero would have small values on both sides
+        if(std::abs(y1) < 1.0 && std::abs(y2) < 1.0)
+        {
+            return std::nullopt;
+        }
+
+        return 0.5 * (x1 + x2);
+    }
+
+}
@@ -0,0 +1,124 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DISCONTINUITYLOCATOR_H
+#define DISCONTINUITYLOCATOR_H
+
+#include <memory>
+#include <optional>
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class DiscontinuityLocator
+     * \brief The DiscontinuityLocator class brackets the places where the graph of an expression
+     *        must be split into branches and narrows them down by bisection.
+     *
+     * A point is inside if the expression is defined there and its absolute value does not exceed the limit.
+     * Branch boundaries are the edges of the domain, the crossings of the limit and poles.
+     */
+    class DiscontinuityLocator final
+    {
+    public:
+        /*!
+         * \brief The Kind enum classifies a branch boundary.
+         */
+        enum class Kind
+        {
+            DomainEdge,
+            Limit,
+            Pole
+        };
+
+        /*!
+         * \brief The Boundary struct describes a branch boundary at a location on the x axis.
+         */
+        struct Boundary
+        {
+            double x;
+            Kind kind;
+        };
+
+    private:
+        std::shared_ptr<Expression> expression;
+        const double limit;
+        const double precision;
+
+    public:
+        /*!
+         * \brief Initializes a new instance for the given expression and parameters.
+         * \param expression The expression to examine.
+         * \param limit The absolute value of y beyond which a point is outside.
+         * \param precision The width of the bracket below which bisection stops.
+         */
+        DiscontinuityLocator(std::shared_ptr<Expression> expression, double limit, double precision);
+        ~DiscontinuityLocator() = default;
+        DiscontinuityLocator(const DiscontinuityLocator&) = delete;
+        DiscontinuityLocator& operator=(const DiscontinuityLocator&) = delete;
+        DiscontinuityLocator(DiscontinuityLocator&&) = delete;
+        DiscontinuityLocator& operator=(DiscontinuityLocator&&) = delete;
+
+        /*!
+         * \brief IsInside indicates whether the expression is defined and within the limit at x.
+         * \param x The location to check.
+         * \return true if the point belongs on a branch.
+         */
+        bool IsInside(double x) const;
+
+        /*!
+         * \brief FindInsideAfter scans for the next point inside and locates the edge at which the branch starts.
+         * \param from The location after which to look, expected to be outside.
+         * \param to The location after which to give up.
+         * \param step The scanning increment, such that narrower parts of the domain may be missed.
+         * \return The boundary at the start of the next branch, or nothing if there is none until \a to.
+         */
+        std::optional<Boundary> FindInsideAfter(double from, double to, double step) const;
+
+        /*!
+         * \brief LocateEdge narrows down the edge between a point inside and a point outside.
+         * \param inside The location known to be inside.
+         * \param outside The location known to be outside, may be left or right of \a inside.
+         * \return The location inside, closest to the edge within the precision.
+         */
+        double LocateEdge(double inside, double outside) const;
+
+        /*!
+         * \brief IsPoleBetween indicates whether the sign change between two points inside stems from a pole.
+         * \param x1 The first location.
+         * \param y1 The value at the first location.
+         * \param x2 The second location.
+         * \param y2 The value at the second location.
+         * \return true if there is a pole between the locations.
+         */
+        bool IsPoleBetween(double x1, double y1, double x2, double y2) const;
+
+        /*!
+         * \brief LocatePole narrows down a pole between two points inside.
+         * \param x1 The first location.
+         * \param y1 The value at the first location.
+         * \param x2 The second location.
+         * \param y2 The value at the second location.
+         * \return The location of the pole, or nothing if the sign change is not due to a pole.
+         */
+        std::optional<double> LocatePole(double x1, double y1, double x2, double y2) const;
+    };
+
+}
+
+#endif // DISCONTINUITYLOCATOR_H
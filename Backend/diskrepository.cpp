@@ -22,14 +22,15 @@
 
 namespace Backend
 {
-    DiskRepository::DiskRepository()
-        : Repository(DeSerializer())
+    DiskRepository::DiskRepository(const std::wstring & directory)
+        : Repository(DeSerializer()),
+          directory(directory)
     {
     }
 
     std::pair<bool, std::wstring> Backend::DiskRepository::Save(const Game& game, const std::wstring& identifier)
     {
-        std::wofstream wofs(identifier);
+        std::wofstream wofs(this->GetPath(identifier));
 
         if(!(wofs.is_open() && wofs.good()))
         {
@@ -52,7 +53,7 @@ namespace Backend
     {
         try
         {
-            std::filesystem::path path(identifier);
+            auto path = this->GetPath(identifier);
             if(!std::filesystem::exists(path))
             {
                 return std::make_pair<bool, std::wstring>(false, std::wstring(L"file does not exist: ") + identifier);
@@ -63,7 +64,7 @@ namespace Backend
             return std::make_pair<bool, std::wstring>(false, std::wstring(L"exception when opening: ") + identifier);
         }
 
-        std::wifstream wifs(identifier);
+        std::wifstream wifs(this->GetPath(identifier));
 
         if(!(wifs.is_open() && wifs.good()))
         {
@@ -76,4 +77,9 @@ namespace Backend
 
         return deserializationResult;
     }
+
+    std::filesystem::path DiskRepository::GetPath(const std::wstring& identifier) const
+    {
+        return this->directory / std::filesystem::path(identifier);
+    }
 }
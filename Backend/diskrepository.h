@@ -19,6 +19,8 @@
 #ifndef DISKREPOSITORY_H
 #define DISKREPOSITORY_H
 
+#include <string>
+#include <filesystem>
 #include "repository.h"
 
 namespace Backend
@@ -26,14 +28,20 @@ namespace Backend
     /*!
      * \class DiskRepository
      * \brief The DiskRepository class persists a game to disk.
+     *
+     * Identifiers are file paths, relative ones being resolved against the directory of the repository.
      */
     class DiskRepository final : public Repository
     {
+    private:
+        const std::filesystem::path directory;
+
     public:
         /*!
          * \brief Initializes a new instance.
+         * \param directory The directory relative identifiers are resolved against, empty meaning the working directory.
          */
-        DiskRepository();
+        explicit DiskRepository(const std::wstring & directory = std::wstring());
 
         /*!
          * \reimp
@@ -44,6 +52,9 @@ namespace Backend
          * \reimp
          */
         virtual std::pair<bool, std::wstring> Load(const std::wstring& identifier, Game& game);
+
+    private:
+        std::filesystem::path GetPath(const std::wstring& identifier) const;
     };
 }
 
@@ -17,7 +17,9 @@
  */
 
 #include <algorithm>
-#include <random>
+#include <array>
+#include <cmath>
+#include <limits>
 #include "dot.h"
 #include "mathhelper.h"
 
@@ -63,7 +65,18 @@ namespace Backend {
         isActive = false;
     }
 
-    bool Dot::CheckForHit(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData)
+    bool Dot::CheckForHit(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, const std::shared_ptr<CancellationToken> cancellationToken)
+    {
+        bool isHit = this->IsHitBy(expression, graphData, cancellationToken);
+        if(isHit)
+        {
+            this->SetIsActive(true);
+        }
+
+        return isHit;
+    }
+
+    bool Dot::IsHitBy(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, const std::shared_ptr<CancellationToken> cancellationToken) const
     {
             bool dotIsHit = false;
             auto xDot = this->GetCoordinates().first;
@@ -75,137 +88,315 @@ namespace Backend {
                 return SquareDistance(x, y, xDot, yDot) <= (rDot * rDot);
             };
 
+            auto isCancelled = [&]()
+            {
+                return cancellationToken && cancellationToken->IsCancelled();
+            };
+
             auto graphDataIt = graphData.begin();
             auto graphDataEnd = graphData.end();
 
-            for(; graphDataIt != graphDataEnd; ++graphDataIt)
+            bool graphCoversDot = false;
+            unsigned int refinementBudget = Dot::MaxRefinementEvaluations;
+
+            for(; graphDataIt != graphDataEnd && !dotIsHit; ++graphDataIt)
             {
-                auto xBegin = graphDataIt->first.begin();
-                auto xEnd = graphDataIt->first.end();
-                auto xIt = std::lower_bound(xBegin, xEnd, xDot - this->GetRadius());
+                if(isCancelled())
+                {
+                    return false;
+                }
+
+                auto & xs = graphDataIt->first;
+                auto & ys = graphDataIt->second;
 
-                auto yIt = graphDataIt->second.begin() + (xIt - xBegin);
+                if(xs.empty())
+                {
+                    continue;
+                }
 
-                auto xIntervalEnd = std::upper_bound(xBegin, xEnd, xDot + this->GetRadius());
+                // the segments reaching into the interval covered by the dot, including those just across its edges
+                auto first = static_cast<size_t>(std::lower_bound(xs.begin(), xs.end(), xDot - rDot) - xs.begin());
+                auto last = static_cast<size_t>(std::upper_bound(xs.begin(), xs.end(), xDot + rDot) - xs.begin());
+                first = first > 0 ? first - 1 : 0;
+                last = std::min(last, xs.size() - 1);
 
-                for(; xIt != xIntervalEnd && xIt != xEnd; ++xIt, ++yIt)
+                if(xs[first] <= xDot + rDot && xs[last] >= xDot - rDot)
                 {
-                    if(isInsideDot(*xIt, *yIt))
-                    {
-                        dotIsHit = true;
-                        break;
-                    }
+                    graphCoversDot = true;
+                }
+
+                if(first == last)
+                {
+                    dotIsHit = isInsideDot(xs[first], ys[first]);
+                    continue;
+                }
+
+                for(size_t i = first; i < last && !dotIsHit; ++i)
+                {
+                    dotIsHit = this->IsSegmentHit(expression, xs[i], ys[i], xs[i + 1], ys[i + 1], refinementBudget);
                 }
             }
 
             if(dotIsHit)
             {
-                this->SetIsActive(true);
                 return true;
             }
 
-            const double localEpsilon = 1e-6;
-            const double dampingFactor = 0.8;
-            const unsigned int maxIterations = 10000;
+            // the graph decides, unless it has nothing to say about the surroundings of the dot
+            if(graphCoversDot)
+            {
+                // chords of a graph only touching the dot stay outside, so try right above or below its center
+                auto centerEvaluationResult = expression->Evaluate(xDot);
+                return centerEvaluationResult.has_value() && isInsideDot(xDot, centerEvaluationResult.value());
+            }
+
+            return this->SearchForHit(expression, cancellationToken);
+    }
+
+    bool Dot::SearchForHit(const std::shared_ptr<Expression> & expression, const std::shared_ptr<CancellationToken> & cancellationToken) const
+    {
+        double rSquare = this->radius * this->radius;
+        unsigned int evaluations = 0;
+
+        auto squareDistanceAt = [&](double x)
+        {
+            ++evaluations;
+            auto evaluationResult = expression->Evaluate(x);
+            return evaluationResult.has_value() ? SquareDistance(x, evaluationResult.value(), this->x, this->y) : std::numeric_limits<double>::infinity();
+        };
 
-            double mid = xDot;
-            double increment = rDot;
+        auto isCancelled = [&]()
+        {
+            return cancellationToken && cancellationToken->IsCancelled();
+        };
 
-            unsigned int iterations = 0;
+        // bracket the closest approach on a grid across the dot, the center being one of the samples
+        std::array<double, Dot::SearchSampleCount> xs;
+        std::array<double, Dot::SearchSampleCount> squareDistances;
+        unsigned int definedCount = 0;
 
-            while (!dotIsHit && increment > localEpsilon && iterations < maxIterations)
+        for(size_t i = 0; i < Dot::SearchSampleCount; ++i)
+        {
+            xs[i] = this->x - this->radius + 2.0 * this->radius * static_cast<double>(i) / (Dot::SearchSampleCount - 1);
+            squareDistances[i] = squareDistanceAt(xs[i]);
+
+            if(squareDistances[i] <= rSquare)
             {
-                auto midEvaluationResult = expression->Evaluate(mid);
-                if (midEvaluationResult.has_value())
-                {
-                    if (isInsideDot(mid, midEvaluationResult.value()))
-                    {
-                        this->SetIsActive(true);
-                        return true;
-                    }
-                }
+                return true;
+            }
+
+            if(std::isfinite(squareDistances[i]))
+            {
+                ++definedCount;
+            }
+        }
+
+        // refine each local minimum, most promising first
+        std::vector<size_t> minima;
+        for(size_t i = 0; i < Dot::SearchSampleCount; ++i)
+        {
+            bool isBelowLeft = i == 0 || squareDistances[i] <= squareDistances[i - 1];
+            bool isBelowRight = i == Dot::SearchSampleCount - 1 || squareDistances[i] <= squareDistances[i + 1];
+            if(std::isfinite(squareDistances[i]) && isBelowLeft && isBelowRight)
+            {
+                minima.emplace_back(i);
+            }
+        }
 
-                auto rightEvaluationResult = expression->Evaluate(mid + increment);
-                if (rightEvaluationResult.has_value())
+        std::sort(minima.begin(), minima.end(), [&](size_t a, size_t b){ return squareDistances[a] < squareDistances[b]; });
+
+        for(auto i : minima)
+        {
+            if(isCancelled() || evaluations >= Dot::MaxSearchEvaluations)
+            {
+                return false;
+            }
+
+            double left = xs[i > 0 ? i - 1 : i];
+            double right = xs[i < Dot::SearchSampleCount - 1 ? i + 1 : i];
+
+            if(this->MinimizeSquareDistance(squareDistanceAt, left, xs[i], squareDistances[i], right, evaluations) <= rSquare)
+            {
+                return true;
+            }
+        }
+
+        // with hardly any of the samples defined the domain is scattered, so try places in between,
+        // spread evenly but the same on every call, so results are reproducible and calls may run concurrently
+        for(unsigned int restart = 1; definedCount < 2 && evaluations < Dot::MaxSearchEvaluations; ++restart)
+        {
+            if(isCancelled())
+            {
+                return false;
+            }
+
+            double squareDistance = squareDistanceAt(this->x + this->radius * (2.0 * Dot::GetLowDiscrepancy(restart) - 1.0));
+            if(squareDistance <= rSquare)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    double Dot::MinimizeSquareDistance(const std::function<double(double)> & squareDistanceAt, double left, double best, double bestValue, double right, unsigned int & evaluations) const
+    {
+        // Brent's method, parabolic steps through the three best points so far, golden section steps where those are not trustworthy
+        const double goldenSection = 0.3819660112501051;
+        const double tolerance = 1e-8;
+        double rSquare = this->radius * this->radius;
+
+        double second = best;
+        double secondValue = bestValue;
+        double third = best;
+        double thirdValue = bestValue;
+        double step = 0.0;
+        double previousStep = 0.0;
+
+        while(evaluations < Dot::MaxSearchEvaluations)
+        {
+            double mid = 0.5 * (left + right);
+            double tolerance1 = tolerance * std::abs(best) + 1e-10;
+            double tolerance2 = 2.0 * tolerance1;
+
+            if(std::abs(best - mid) <= tolerance2 - 0.5 * (right - left))
+            {
+                break;
+            }
+
+            bool useGoldenSection = true;
+            if(std::abs(previousStep) > tolerance1 && std::isfinite(secondValue) && std::isfinite(thirdValue))
+            {
+                double r = (best - second) * (bestValue - thirdValue);
+                double q = (best - third) * (bestValue - secondValue);
+                double p = (best - third) * q - (best - second) * r;
+                q = 2.0 * (q - r);
+                if(q > 0.0)
                 {
-                    if (isInsideDot(mid + increment, rightEvaluationResult.value()))
-                    {
-                        this->SetIsActive(true);
-                        return true;
-                    }
+                    p = -p;
                 }
+                q = std::abs(q);
 
-                auto leftEvaluationResult = expression->Evaluate(mid - increment);
-                if (leftEvaluationResult.has_value())
+                double stepBeforeLast = previousStep;
+                previousStep = step;
+
+                if(std::abs(p) < std::abs(0.5 * q * stepBeforeLast) && p > q * (left - best) && p < q * (right - best))
                 {
-                    if (isInsideDot(mid - increment, leftEvaluationResult.value()))
+                    step = p / q;
+                    double candidate = best + step;
+                    if(candidate - left < tolerance2 || right - candidate < tolerance2)
                     {
-                        this->SetIsActive(true);
-                        return true;
+                        step = mid > best ? tolerance1 : -tolerance1;
                     }
+                    useGoldenSection = false;
                 }
+            }
 
-                // well, that was easy. Now the hard part.
-                if (midEvaluationResult.has_value() && rightEvaluationResult.has_value() && leftEvaluationResult.has_value())
-                {
-                    auto leftGradient = SquareDistance(xDot, yDot, mid - increment, leftEvaluationResult.has_value());
-                    auto rightGradient = SquareDistance(xDot, yDot, mid + increment, rightEvaluationResult.has_value());
-
-                    if (leftGradient < rightGradient)
-                    {
-                        increment *= leftGradient < 10 ? leftGradient / 20 : 0.75;
-                        mid -= increment;
-                    }
-                    else
-                    {
-                        increment *= rightGradient < 10 ? rightGradient / 20 : 0.75;
-                        mid += increment;
-                    }
+            if(useGoldenSection)
+            {
+                previousStep = best >= mid ? left - best : right - best;
+                step = goldenSection * previousStep;
+            }
 
-                    continue;
-                }
+            double candidate = std::abs(step) >= tolerance1 ? best + step : best + (step > 0.0 ? tolerance1 : -tolerance1);
+            double candidateValue = squareDistanceAt(candidate);
 
-                // from now on, we are in desperate trouble, and eventually skip out
-                iterations++;
+            if(candidateValue <= rSquare)
+            {
+                return candidateValue;
+            }
 
-                // in the following cases, damp the movement
-                if (midEvaluationResult.has_value() && rightEvaluationResult.has_value())
-                {
-                    mid += increment * dampingFactor;
-                    increment *= 0.5;
-                    continue;
-                }
-                else if (midEvaluationResult.has_value() && leftEvaluationResult.has_value())
-                {
-                    mid -= increment * dampingFactor;
-                    increment *= 0.5;
-                    continue;
-                }
-                else if (rightEvaluationResult.has_value())
+            if(candidateValue <= bestValue)
+            {
+                (candidate >= best ? left : right) = best;
+                third = second;
+                thirdValue = secondValue;
+                second = best;
+                secondValue = bestValue;
+                best = candidate;
+                bestValue = candidateValue;
+            }
+            else
+            {
+                (candidate < best ? left : right) = candidate;
+                if(candidateValue <= secondValue || second == best)
                 {
-                    mid += increment * dampingFactor;
-                    continue;
+                    third = second;
+                    thirdValue = secondValue;
+                    second = candidate;
+                    secondValue = candidateValue;
                 }
-                else if (leftEvaluationResult.has_value())
+                else if(candidateValue <= thirdValue || third == best || third == second)
                 {
-                    mid -= increment * dampingFactor;
-                    continue;
+                    third = candidate;
+                    thirdValue = candidateValue;
                 }
-
-                // if everything else fails, pick a new random Mid somewhere in the dot
-                double rand = Dot::GetRandom();
-                mid = xDot + rDot * 0.75 * (rand - 0.5);
             }
+        }
 
+        return bestValue;
+    }
+
+    bool Dot::IsSegmentHit(const std::shared_ptr<Expression> & expression, double x1, double y1, double x2, double y2, unsigned int & refinementBudget) const
+    {
+        double rSquare = this->radius * this->radius;
+
+        if(SquareDistance(x1, y1, this->x, this->y) <= rSquare || SquareDistance(x2, y2, this->x, this->y) <= rSquare)
+        {
+            return true;
+        }
+
+        // closest point of the chord to the center
+        double dx = x2 - x1;
+        double dy = y2 - y1;
+        double lengthSquare = dx * dx + dy * dy;
+        double t = lengthSquare > 0.0 ? std::clamp(((this->x - x1) * dx + (this->y - y1) * dy) / lengthSquare, 0.0, 1.0) : 0.0;
+        double chordSquareDistance = SquareDistance(x1 + t * dx, y1 + t * dy, this->x, this->y);
+
+        // the graph strays from its chord by less than half the chord length unless it turns sharply,
+        // which the evaluator prevents by keeping chords short, so farther away the chord decides
+        double slack = this->radius + 0.5 * std::sqrt(lengthSquare);
+        if(chordSquareDistance > slack * slack)
+        {
             return false;
+        }
+
+        if(refinementBudget == 0 || dx < Dot::MinimumRefinementWidth)
+        {
+            return chordSquareDistance <= rSquare;
+        }
+
+        // split where the chord comes closest, but keep away from the ends so the parts shrink
+        double xSplit = x1 + std::clamp(t, 0.1, 0.9) * dx;
+        --refinementBudget;
+        auto ySplit = expression->Evaluate(xSplit);
+
+        // no graph across a gap in the domain
+        if(!ySplit.has_value())
+        {
+            return false;
+        }
+
+        return this->IsSegmentHit(expression, x1, y1, xSplit, ySplit.value(), refinementBudget)
+                || this->IsSegmentHit(expression, xSplit, ySplit.value(), x2, y2, refinementBudget);
     }
 
-    /* static class member */ double Dot::GetRandom()
+    /* static class member */ double Dot::GetLowDiscrepancy(unsigned int index)
     {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_real_distribution<> dis(0.0, 1.0);
-        return dis(gen);
+        // van der Corput sequence: the binary digits of the index mirrored behind the point
+        double value = 0.0;
+        double digitValue = 0.5;
+
+        for(; index > 0; index >>= 1, digitValue *= 0.5)
+        {
+            if(index & 1u)
+            {
+                value += digitValue;
+            }
+        }
+
+        return value;
     }
 
 }
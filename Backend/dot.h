@@ -21,8 +21,10 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
 
 #include "expression.h"
+#include "cancellationtoken.h"
 
 namespace Backend {
 
@@ -33,6 +35,26 @@ namespace Backend {
     class Dot final
     {
     private:
+        /*!
+         * \brief MaxRefinementEvaluations is the number of evaluations a hit check may spend on refining chords of the graph.
+         */
+        constexpr static const unsigned int MaxRefinementEvaluations = 64;
+
+        /*!
+         * \brief MinimumRefinementWidth is the width in x below which a chord is not refined any further.
+         */
+        constexpr static const double MinimumRefinementWidth = 1e-9;
+
+        /*!
+         * \brief SearchSampleCount is the number of samples across the dot bracketing the closest approach of a graph.
+         */
+        constexpr static const size_t SearchSampleCount = 9;
+
+        /*!
+         * \brief MaxSearchEvaluations is the number of evaluations a search for the closest approach of a graph may spend.
+         */
+        constexpr static const unsigned int MaxSearchEvaluations = 64;
+
         double x;
         double y;
         double radius;
@@ -84,25 +106,79 @@ namespace Backend {
         void ResetIsActive();
 
         /*!
-         * \brief CheckForHit checks whether the dot is hit by the current expression and its graph data.
+         * \brief Sets the IsActive value.
+         * \param isActive Value indicating whether the dot is active.
+         */
+        void SetIsActive(bool isActive);
+
+        /*!
+         * \brief CheckForHit checks whether the dot is hit by the current expression and its graph data, and if so, sets it active.
          * \param expression The current expression.
          * \param graphData The otherwise created graph data for the expression.
+         * \param cancellationToken The optional token to stop the check early, which then reports no hit.
          * \return true if the dot is hit by the expression/graph.
          */
-        bool CheckForHit(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData);
+        bool CheckForHit(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, const std::shared_ptr<CancellationToken> cancellationToken = nullptr);
+
+        /*!
+         * \brief IsHitBy checks whether the dot is hit by the current expression and its graph data, leaving the dot unchanged.
+         *
+         * The chords between consecutive points of the graph are intersected with the circle of the dot.
+         * Where a chord comes close enough for the curvature of the graph to matter, it is refined by evaluating the expression,
+         * up to \ref MaxRefinementEvaluations times. Only if the graph data does not reach the dot,
+         * the closest approach of the expression to the center is searched, see \ref SearchForHit.
+         * Safe to call concurrently, for the same or different dots and expressions.
+         * \param expression The current expression.
+         * \param graphData The otherwise created graph data for the expression.
+         * \param cancellationToken The optional token to stop the check early, which then reports no hit.
+         * \return true if the dot is hit by the expression/graph.
+         */
+        bool IsHitBy(const std::shared_ptr<Expression> expression, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, const std::shared_ptr<CancellationToken> cancellationToken = nullptr) const;
 
     private:
         /*!
-         * \brief GetRandom provides a random number between 0.0 and 1.0.
-         * \return A random number between 0.0 and 1.0.
+         * \brief IsSegmentHit checks whether the graph between two of its points hits the dot.
+         * \param expression The expression underlying the graph.
+         * \param x1 The x coordinate of the left point.
+         * \param y1 The y coordinate of the left point.
+         * \param x2 The x coordinate of the right point.
+         * \param y2 The y coordinate of the right point.
+         * \param refinementBudget The number of evaluations left for refinement, decreased by those spent.
+         * \return true if the dot is hit.
          */
-        static double GetRandom();
+        bool IsSegmentHit(const std::shared_ptr<Expression> & expression, double x1, double y1, double x2, double y2, unsigned int & refinementBudget) const;
 
         /*!
-         * \brief Sets the IsActive value.
-         * \param isActive Value indicating whether the dot is active.
+         * \brief SearchForHit searches the closest approach of the graph of the expression to the center of the dot.
+         *
+         * The square distance (x - x0)^2 + (f(x) - y0)^2 is sampled across [x0 - r, x0 + r], and each local minimum among the samples
+         * is refined by Brent's method. Where most of the samples are undefined, places across the dot from a low-discrepancy sequence are tried instead.
+         * No more than \ref MaxSearchEvaluations evaluations are spent.
+         * \param expression The expression to search.
+         * \param cancellationToken The optional token to stop the search early, which then reports no hit.
+         * \return true if the dot is hit.
          */
-        void SetIsActive(bool isActive);
+        bool SearchForHit(const std::shared_ptr<Expression> & expression, const std::shared_ptr<CancellationToken> & cancellationToken) const;
+
+        /*!
+         * \brief MinimizeSquareDistance narrows down a minimum of the square distance to the center within a bracket.
+         * \param squareDistanceAt The square distance as a function of x, infinite where undefined.
+         * \param left The left end of the bracket.
+         * \param best The location of the lowest value known, inside the bracket.
+         * \param bestValue The lowest value known.
+         * \param right The right end of the bracket.
+         * \param evaluations The number of evaluations spent so far, increased by those spent here.
+         * \return The lowest square distance found, which is at most the square radius if the dot is hit.
+         */
+        double MinimizeSquareDistance(const std::function<double(double)> & squareDistanceAt, double left, double best, double bestValue, double right, unsigned int & evaluations) const;
+
+        /*!
+         * \brief GetLowDiscrepancy provides the element of a deterministic sequence evenly filling the interval between 0.0 and 1.0.
+         * \param index The index of the element, starting at 1.
+         * \return A number between 0.0 and 1.0.
+         */
+        static double GetLowDiscrepancy(unsigned int index);
+
     };
 
 }
@@ -0,0 +1,153 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include "dotgrid.h"
+
+namespace Backend {
+
+    DotGrid::DotGrid(const std::vector<std::shared_ptr<Dot>> & dots, double cellSize)
+        : originX(0.0),
+          originY(0.0),
+          cellSize(cellSize),
+          columnCount(0),
+          rowCount(0),
+          dotCount(dots.size())
+    {
+        if(cellSize <= 0.0)
+        {
+            throw std::exception("non-positive cell size not allowed");
+        }
+
+        if(dots.empty())
+        {
+            return;
+        }
+
+        // cover the bounding boxes of all dots, with the origin on a multiple of half a cell so lattice points end up in cell centres
+        double minX = dots.front()->GetCoordinates().first;
+        double minY = dots.front()->GetCoordinates().second;
+        double maxX = minX;
+        double maxY = minY;
+
+        for(auto & dot : dots)
+        {
+            auto [x, y] = dot->GetCoordinates();
+            auto r = dot->GetRadius();
+            minX = std::min(minX, x - r);
+            minY = std::min(minY, y - r);
+            maxX = std::max(maxX, x + r);
+            maxY = std::max(maxY, y + r);
+        }
+
+        this->originX = (std::floor(minX / cellSize - 0.5) + 0.5) * cellSize;
+        this->originY = (std::floor(minY / cellSize - 0.5) + 0.5) * cellSize;
+        this->columnCount = this->ColumnOf(maxX) + 1;
+        this->rowCount = this->RowOf(maxY) + 1;
+        this->cells.resize(static_cast<size_t>(this->columnCount * this->rowCount));
+
+        for(size_t dotIndex = 0; dotIndex < dots.size(); ++dotIndex)
+        {
+            auto [x, y] = dots[dotIndex]->GetCoordinates();
+            auto r = dots[dotIndex]->GetRadius();
+
+            for(long long row = this->RowOf(y - r); row <= this->RowOf(y + r); ++row)
+            {
+                for(long long column = this->ColumnOf(x - r); column <= this->ColumnOf(x + r); ++column)
+                {
+                    this->cells[static_cast<size_t>(row * this->columnCount + column)].emplace_back(dotIndex);
+                }
+            }
+        }
+    }
+
+    std::vector<size_t> DotGrid::GetCandidates(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData) const
+    {
+        std::vector<bool> isCandidate(this->dotCount, false);
+
+        for(auto & branch : graphData)
+        {
+            auto & xs = branch.first;
+            auto & ys = branch.second;
+
+            if(xs.size() == 1)
+            {
+                this->MarkCandidates(xs[0], ys[0], xs[0], ys[0], isCandidate);
+            }
+
+            for(size_t i = 1; i < xs.size(); ++i)
+            {
+                this->MarkCandidates(xs[i - 1], ys[i - 1], xs[i], ys[i], isCandidate);
+            }
+        }
+
+        std::vector<size_t> candidates;
+        for(size_t dotIndex = 0; dotIndex < this->dotCount; ++dotIndex)
+        {
+            if(isCandidate[dotIndex])
+            {
+                candidates.emplace_back(dotIndex);
+            }
+        }
+
+        return candidates;
+    }
+
+    size_t DotGrid::GetCellCount() const
+    {
+        return this->cells.size();
+    }
+
+    long long DotGrid::ColumnOf(double x) const
+    {
+        return static_cast<long long>(std::floor((x - this->originX) / this->cellSize));
+    }
+
+    long long DotGrid::RowOf(double y) const
+    {
+        return static_cast<long long>(std::floor((y - this->originY) / this->cellSize));
+    }
+
+    void DotGrid::MarkCandidates(double x1, double y1, double x2, double y2, std::vector<bool> & isCandidate) const
+    {
+        // the graph may stray from its chord by half the chord length, see Dot::IsSegmentHit, so the box is padded by as much,
+        // and clamped to the grid before it is turned into cells so long chords near poles stay in range
+        double padding = 0.5 * std::hypot(x2 - x1, y2 - y1);
+        double maxX = this->originX + static_cast<double>(this->columnCount) * this->cellSize;
+        double maxY = this->originY + static_cast<double>(this->rowCount) * this->cellSize;
+
+        auto firstColumn = std::max(0LL, this->ColumnOf(std::clamp(std::min(x1, x2) - padding, this->originX, maxX)));
+        auto lastColumn = std::min(this->columnCount - 1, this->ColumnOf(std::clamp(std::max(x1, x2) + padding, this->originX, maxX)));
+        auto firstRow = std::max(0LL, this->RowOf(std::clamp(std::min(y1, y2) - padding, this->originY, maxY)));
+        auto lastRow = std::min(this->rowCount - 1, this->RowOf(std::clamp(std::max(y1, y2) + padding, this->originY, maxY)));
+
+        for(auto row = firstRow; row <= lastRow; ++row)
+        {
+            for(auto column = firstColumn; column <= lastColumn; ++column)
+            {
+                for(auto dotIndex : this->cells[static_cast<size_t>(row * this->columnCount + column)])
+                {
+                    isCandidate[dotIndex] = true;
+                }
+            }
+        }
+    }
+
+}
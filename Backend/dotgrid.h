@@ -0,0 +1,81 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DOTGRID_H
+#define DOTGRID_H
+
+#include <vector>
+#include <memory>
+#include "dot.h"
+
+namespace Backend {
+
+    /*!
+     * \class DotGrid
+     * \brief The DotGrid class is a uniform grid index over the bounding boxes of dots.
+     *
+     * Each dot is registered in every cell its bounding box overlaps. The segments between consecutive points of a graph
+     * are rasterized into the cells their bounding boxes overlap, and only the dots registered there are candidates for a hit.
+     * With the default cell size of 1.0 the cells match the lattice the \ref RandomDotGenerator places its dots on.
+     */
+    class DotGrid final
+    {
+    private:
+        double originX;
+        double originY;
+        double cellSize;
+        long long columnCount;
+        long long rowCount;
+        size_t dotCount;
+        std::vector<std::vector<size_t>> cells;
+
+    public:
+        /*!
+         * \brief Initializes a new instance indexing the given dots.
+         * \param dots The dots to index, which are later referred to by their index in this vector.
+         * \param cellSize The width and height of a cell, which must be positive.
+         */
+        DotGrid(const std::vector<std::shared_ptr<Dot>> & dots, double cellSize = 1.0);
+        ~DotGrid() = default;
+        DotGrid(const DotGrid&) = delete;
+        DotGrid& operator=(const DotGrid&) = delete;
+        DotGrid(DotGrid&&) = delete;
+        DotGrid& operator=(DotGrid&&) = delete;
+
+        /*!
+         * \brief GetCandidates gets the dots that may be hit by the graph.
+         * \param graphData The branches of the graph.
+         * \return The indices of the dots in cells the graph may pass between its points, in ascending order.
+         */
+        std::vector<size_t> GetCandidates(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData) const;
+
+        /*!
+         * \brief GetCellCount gets the number of cells in the grid.
+         * \return The number of cells covering all dots.
+         */
+        size_t GetCellCount() const;
+
+    private:
+        long long ColumnOf(double x) const;
+        long long RowOf(double y) const;
+        void MarkCandidates(double x1, double y1, double x2, double y2, std::vector<bool> & isCandidate) const;
+    };
+
+}
+
+#endif // DOTGRID_H
@@ -0,0 +1,135 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include "dotset.h"
+
+namespace Backend {
+
+    DotSet::DotSet(const std::vector<std::shared_ptr<Dot>> & dots)
+        : blocks((dots.size() + LaneCount - 1) / LaneCount),
+          dotCount(dots.size())
+    {
+        for(size_t blockIndex = 0; blockIndex < this->blocks.size(); ++blockIndex)
+        {
+            auto & block = this->blocks[blockIndex];
+
+            for(size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                size_t dotIndex = blockIndex * LaneCount + lane;
+
+                // lanes past the last dot get a negative square radius, which nothing is inside of
+                if(dotIndex >= dots.size())
+                {
+                    block.x[lane] = 0.0;
+                    block.y[lane] = 0.0;
+                    block.rSquare[lane] = -1.0;
+                    continue;
+                }
+
+                auto coordinates = dots[dotIndex]->GetCoordinates();
+                auto radius = dots[dotIndex]->GetRadius();
+                block.x[lane] = coordinates.first;
+                block.y[lane] = coordinates.second;
+                block.rSquare[lane] = radius * radius;
+            }
+        }
+    }
+
+    std::vector<bool> DotSet::FindDotsHitBySamples(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData) const
+    {
+        std::vector<double> closestSquareDistances;
+        return this->FindDotsHitBySamples(graphData, closestSquareDistances);
+    }
+
+    std::vector<bool> DotSet::FindDotsHitBySamples(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, std::vector<double> & closestSquareDistances) const
+    {
+        std::vector<long long> isHit(this->blocks.size() * LaneCount, 0);
+        std::vector<double> closest(this->blocks.size() * LaneCount, std::numeric_limits<double>::infinity());
+
+        for(auto & branch : graphData)
+        {
+            auto sampleCount = std::min(branch.first.size(), branch.second.size());
+
+            for(size_t sampleStart = 0; sampleStart < sampleCount; sampleStart += SampleBlockSize)
+            {
+                // one sample more than the block, so the chord to the next block is measured too
+                auto blockSampleCount = std::min(SampleBlockSize + 1, sampleCount - sampleStart);
+                auto xs = branch.first.data() + sampleStart;
+                auto ys = branch.second.data() + sampleStart;
+
+                for(size_t blockIndex = 0; blockIndex < this->blocks.size(); ++blockIndex)
+                {
+                    DotSet::MarkBlockHitBySamples(this->blocks[blockIndex], xs, ys, blockSampleCount, isHit.data() + blockIndex * LaneCount, closest.data() + blockIndex * LaneCount);
+                }
+            }
+        }
+
+        std::vector<bool> result(this->dotCount);
+        for(size_t dotIndex = 0; dotIndex < this->dotCount; ++dotIndex)
+        {
+            result[dotIndex] = isHit[dotIndex] != 0;
+        }
+
+        closest.resize(this->dotCount);
+        closestSquareDistances = closest;
+
+        return result;
+    }
+
+    /* static class member */ void DotSet::MarkBlockHitBySamples(const Block & block, const double * xs, const double * ys, size_t sampleCount, long long * isHit, double * closestSquareDistances)
+    {
+        // kept branch-free with a fixed lane count, so the inner loop vectorizes
+        long long hits[LaneCount] = {};
+        double closest[LaneCount];
+        std::copy(closestSquareDistances, closestSquareDistances + LaneCount, closest);
+
+        for(size_t i = 0; i < sampleCount; ++i)
+        {
+            double x = xs[i];
+            double y = ys[i];
+
+            // the last sample is a chord of zero length
+            size_t next = i + 1 < sampleCount ? i + 1 : i;
+            double chordX = xs[next] - x;
+            double chordY = ys[next] - y;
+            double chordSquare = chordX * chordX + chordY * chordY;
+            double inverseChordSquare = chordSquare > 0.0 ? 1.0 / chordSquare : 0.0;
+
+            for(size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                double dx = x - block.x[lane];
+                double dy = y - block.y[lane];
+                hits[lane] |= static_cast<long long>(dx * dx + dy * dy <= block.rSquare[lane]);
+
+                double t = std::min(1.0, std::max(0.0, -(dx * chordX + dy * chordY) * inverseChordSquare));
+                double closestX = dx + t * chordX;
+                double closestY = dy + t * chordY;
+                closest[lane] = std::min(closest[lane], closestX * closestX + closestY * closestY);
+            }
+        }
+
+        for(size_t lane = 0; lane < LaneCount; ++lane)
+        {
+            isHit[lane] |= hits[lane];
+            closestSquareDistances[lane] = closest[lane];
+        }
+    }
+
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef DOTSET_H
+#define DOTSET_H
+
+#include <vector>
+#include <memory>
+#include "dot.h"
+
+namespace Backend {
+
+    /*!
+     * \class DotSet
+     * \brief The DotSet class keeps the circles of dots in blocked structure-of-arrays form to test many graph samples against them at once.
+     *
+     * Centers and square radii are stored in aligned blocks of \ref LaneCount dots each, so the kernel comparing
+     * a block of samples against a block of dots compiles to vector instructions without needing intrinsics.
+     */
+    class DotSet final
+    {
+    public:
+        /*!
+         * \brief LaneCount is the number of dots per block, matching four doubles per 256 bit vector register.
+         */
+        constexpr static const size_t LaneCount = 4;
+
+        /*!
+         * \brief SampleBlockSize is the number of samples streamed against all dots at once, small enough to stay in cache.
+         */
+        constexpr static const size_t SampleBlockSize = 256;
+
+    private:
+        struct alignas(32) Block
+        {
+            double x[LaneCount];
+            double y[LaneCount];
+            double rSquare[LaneCount];
+        };
+
+        std::vector<Block> blocks;
+        size_t dotCount;
+
+    public:
+        /*!
+         * \brief Initializes a new instance from the given dots.
+         * \param dots The dots, which are later referred to by their index in this vector.
+         */
+        explicit DotSet(const std::vector<std::shared_ptr<Dot>> & dots);
+        ~DotSet() = default;
+        DotSet(const DotSet&) = delete;
+        DotSet& operator=(const DotSet&) = delete;
+        DotSet(DotSet&&) = delete;
+        DotSet& operator=(DotSet&&) = delete;
+
+        /*!
+         * \brief FindDotsHitBySamples finds the dots that contain any sample of the graph in a single pass over the graph.
+         * \param graphData The branches of the graph.
+         * \return For every dot, whether a sample lies inside it.
+         */
+        std::vector<bool> FindDotsHitBySamples(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData) const;
+
+        /*!
+         * \brief FindDotsHitBySamples finds the dots that contain any sample of the graph and how close the graph comes to each dot
+         *        in a single pass over the graph.
+         * \param graphData The branches of the graph.
+         * \param closestSquareDistances Receives for every dot the square distance of its center to the closest chord between samples,
+         *        infinity if the graph is empty.
+         * \return For every dot, whether a sample lies inside it.
+         */
+        std::vector<bool> FindDotsHitBySamples(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graphData, std::vector<double> & closestSquareDistances) const;
+
+    private:
+        static void MarkBlockHitBySamples(const Block & block, const double * xs, const double * ys, size_t sampleCount, long long * isHit, double * closestSquareDistances);
+    };
+
+}
+
+#endif // DOTSET_H
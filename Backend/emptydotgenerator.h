@@ -0,0 +1,47 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef EMPTYDOTGENERATOR_H
+#define EMPTYDOTGENERATOR_H
+
+#include "dotgenerator.h"
+
+namespace Backend
+{
+    /*!
+     * \class EmptyDotGenerator
+     * \brief The EmptyDotGenerator class creates no dots, for games whose dots are supplied otherwise, e.g. by loading.
+     *
+     * It holds no state, so one instance can be used by any number of threads at once.
+     */
+    class EmptyDotGenerator final : public DotGenerator
+    {
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         */
+        EmptyDotGenerator() = default;
+
+        /*!
+         * \reimp
+         */
+        virtual std::vector<std::shared_ptr<Dot>> Generate();
+    };
+}
+
+#endif // EMPTYDOTGENERATOR_H
@@ -17,30 +17,32 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include "evaluator.h"
 #include "mathhelper.h"
 
 namespace Backend {
 
-    Evaluator::Evaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit)
-        : expression(expression),
+    Evaluator::Evaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit, double detail, std::shared_ptr<CancellationToken> cancellationToken)
+        : Epsilon(1e-4 / detail),
+          MinimumSquareDistance(1e-4 / (detail * detail)),
+          TargetDistance(5e-3 / (detail * detail)),
+          InitialIncrement(1e-3 / detail),
+          LargeIncrement(1e-2 / detail),
+          Precision(1e-8 / detail),
+          expression(expression),
           minX(minX),
           maxX(maxX),
           limit(limit),
+          cancellationToken(cancellationToken),
           EvaluateWasCalled(false),
           AddPointToCurrentBranchAtWasCalled(false)
     {
-    }
-
-    static double forwardX(double in)
-    {
-        return in;
-    }
-
-    static double backwardX(double in)
-    {
-        return -in;
+        if(detail <= 0.0)
+        {
+            throw std::exception("non-positive detail not allowed");
+        }
     }
 
     std::vector<std::pair<std::vector<double>, std::vector<double>>> Evaluator::Evaluate()
@@ -58,42 +60,40 @@ namespace Backend {
 
     void Evaluator::CreateGraph()
     {
-        double lastXinPreviousInterval = this->minX;
-        double x = lastXinPreviousInterval;
+        DiscontinuityLocator locator(this->expression, this->limit, this->Precision);
+        double x = this->minX;
 
-        while (x < this->maxX)
+        while (x < this->maxX && !this->IsCancelled())
         {
             if(graphData.size() == 0 || !graphData.back().first.empty())
             {
                 graphData.emplace_back(std::make_pair(std::vector<double>(),std::vector<double>()));
             }
 
-            // look for interval
-            double xInCurrentInterval = lastXinPreviousInterval;
-            bool foundInterval = false;
-            while (!foundInterval && xInCurrentInterval < this->maxX)
+            // look for interval, starting at its located edge
+            double start = x;
+            bool steepStart = false;
+            if(!locator.IsInside(x))
             {
-                xInCurrentInterval += this->LargeIncrement;
-                auto result = this->expression->Evaluate(xInCurrentInterval);
-                foundInterval = result.has_value();
-            }
+                auto boundary = locator.FindInsideAfter(x, this->maxX, this->LargeIncrement);
 
-            // maybe the function is not defined anywhere in our window
-            if (!foundInterval)
-            {
-                break;
-            }
-
-            double lastXinCurrentInterval;
+                // maybe the function is not defined anywhere in the rest of our window
+                if(!boundary.has_value() || boundary->x > this->maxX)
+                {
+                    break;
+                }
 
-            // work inside interval - backward
-            this->WorkAnInterval(backwardX, x, xInCurrentInterval, lastXinCurrentInterval);
+                if(this->boundaries.empty() || this->boundaries.back().kind != DiscontinuityLocator::Kind::Pole)
+                {
+                    this->boundaries.emplace_back(boundary.value());
+                }
 
-            // work inside interval - forward
-            this->WorkAnInterval(forwardX, x, xInCurrentInterval, lastXinCurrentInterval);
+                start = boundary->x;
+                steepStart = this->boundaries.back().kind != DiscontinuityLocator::Kind::DomainEdge;
+            }
 
-            // finish up interval
-            lastXinPreviousInterval = lastXinCurrentInterval;
+            // work inside interval
+            x = this->WorkAnInterval(locator, start, steepStart);
         }
 
         while(graphData.size() > 1)
@@ -112,6 +112,11 @@ namespace Backend {
         }
     }
 
+    bool Evaluator::IsCancelled() const
+    {
+        return this->cancellationToken && this->cancellationToken->IsCancelled();
+    }
+
     bool Evaluator::AddPointToCurrentBranchAt(double x)
     {
         if(EvaluateWasCalled)
@@ -176,52 +181,168 @@ namespace Backend {
         }
     }
 
-    void Evaluator::WorkAnInterval(double (*direction)(double), double & x, double xInCurrentInterval, double & xOld)
+    std::optional<DiscontinuityLocator::Boundary> Evaluator::FindOutside(const DiscontinuityLocator& locator, double x, double y, double probe) const
     {
-        x = xInCurrentInterval + direction(Epsilon);
-        auto yOptional = this->expression->Evaluate(x);
-        xOld = xInCurrentInterval;
-
-        double y = yOptional.value_or(0.0);
-        double yOld = yOptional.value_or(this->expression->Evaluate(xInCurrentInterval).value());
+        auto probeOptional = this->expression->Evaluate(probe);
+        if (!probeOptional.has_value())
+        {
+            return DiscontinuityLocator::Boundary{probe, DiscontinuityLocator::Kind::DomainEdge};
+        }
 
-        double incr = this->InitialIncrement;
+        if (std::abs(probeOptional.value()) > this->limit)
+        {
+            return DiscontinuityLocator::Boundary{probe, DiscontinuityLocator::Kind::Limit};
+        }
 
-        // scan the interval until it is interrupted
-        bool interrupt = false;
-        while (!interrupt)
+        // the probe may have stepped across the pole to the other side
+        auto pole = locator.LocatePole(x, y, probe, probeOptional.value());
+        if (pole.has_value() && !locator.IsInside(pole.value()))
         {
-            interrupt = true;
-            yOptional = this->expression->Evaluate(x);
+            return DiscontinuityLocator::Boundary{pole.value(), DiscontinuityLocator::Kind::Pole};
+        }
 
+        return std::nullopt;
+    }
+
+    void Evaluator::AddApproachToCurrentBranch(double x, double edge)
+    {
+        // halve the distance to the edge each time, which keeps the shape of the steep part with few points
+        double distance = 0.5 * (edge - x);
+        while (distance > this->Epsilon)
+        {
+            auto yOptional = this->expression->Evaluate(edge - distance);
             if (yOptional.has_value())
             {
+                this->AddCompletePointToCurrentBranch(edge - distance, yOptional.value());
+            }
+
+            distance *= 0.5;
+        }
+
+        if (edge > x)
+        {
+            this->AddCompletePointToCurrentBranch(edge, this->expression->Evaluate(edge).value());
+        }
+    }
+
+    std::vector<DiscontinuityLocator::Boundary> Evaluator::GetBoundaries() const
+    {
+        return this->boundaries;
+    }
+
+    double Evaluator::WorkAnInterval(const DiscontinuityLocator& locator, double start, bool steepStart)
+    {
+        double x = start;
+        double y = this->expression->Evaluate(x).value();
+        this->AddCompletePointToCurrentBranch(x, y);
+
+        double incr = this->InitialIncrement;
+
+        // leaving a pole, double the distance to it each time until the graph has flattened enough for the usual steps
+        if (steepStart)
+        {
+            double distance = this->Epsilon;
+            while (start + distance <= this->maxX)
+            {
+                auto yOptional = this->expression->Evaluate(start + distance);
+                if (!yOptional.has_value() || std::abs(yOptional.value()) > this->limit)
+                {
+                    break;
+                }
+
+                double slope = std::abs(yOptional.value() - y) / (start + distance - x);
+                x = start + distance;
                 y = yOptional.value();
-                interrupt = !(this->minX <= x && x <= this->maxX && -this->limit <= y && y <= this->limit);
+                this->AddCompletePointToCurrentBranch(x, y);
+
+                if (slope * this->Epsilon * slope * this->Epsilon < this->TargetDistance)
+                {
+                    incr = 0.5 * distance;
+                    break;
+                }
+
+                distance *= 2.0;
+            }
+        }
+
+        double probedUntil = x;
+
+        // the first step is a short one, which lets the increment grow right away on flat graphs
+        bool isFirstStep = !steepStart;
+
+        // scan the interval until it is interrupted, then return where to look for the next one
+        while (!this->IsCancelled())
+        {
+            double xNext = x + (isFirstStep ? this->Epsilon : incr);
+            isFirstStep = false;
+            if (xNext > this->maxX)
+            {
+                return xNext;
+            }
+
+            auto yOptional = this->expression->Evaluate(xNext);
+            if (!yOptional.has_value() || std::abs(yOptional.value()) > this->limit)
+            {
+                double edge = locator.LocateEdge(x, xNext);
+                if (edge > x)
+                {
+                    this->AddCompletePointToCurrentBranch(edge, this->expression->Evaluate(edge).value());
+                }
+
+                auto kind = yOptional.has_value() ? DiscontinuityLocator::Kind::Limit : DiscontinuityLocator::Kind::DomainEdge;
+                this->boundaries.emplace_back(DiscontinuityLocator::Boundary{edge, kind});
+                return xNext;
+            }
+
+            double yNext = yOptional.value();
+
+            // the limit does not catch poles stepped across at once
+            auto pole = locator.LocatePole(x, y, xNext, yNext);
+            if (pole.has_value())
+            {
+                this->boundaries.emplace_back(DiscontinuityLocator::Boundary{pole.value(), DiscontinuityLocator::Kind::Pole});
+                // the next interval must start beyond the pole, even where the precision is below the spacing of doubles
+                return std::max(pole.value() + this->Precision, std::nextafter(pole.value(), HUGE_VAL));
             }
 
-            if (!interrupt)
+            double squareDist = SquareDistance(xNext, yNext, x, y);
+            if (squareDist < this->TargetDistance || incr < this->Epsilon)
             {
-                double squareDist = SquareDistance(x, y, xOld, yOld);
-                if (squareDist < this->TargetDistance || incr < this->Epsilon)
+                // steep and growing, the graph may be heading for a pole, no need to crawl up to it
+                if (incr < this->Epsilon && xNext > probedUntil && std::abs(yNext) > std::abs(y))
                 {
-                    if (squareDist < this->Epsilon)
+                    // near a pole y behaves like c / (pole - x), so y / y' estimates the distance to it
+                    double probe = std::min(xNext + std::abs(yNext) * (xNext - x) / std::abs(yNext - y), this->maxX);
+                    probedUntil = probe;
+
+                    auto outside = this->FindOutside(locator, xNext, yNext, probe);
+                    if (outside.has_value())
                     {
-                        incr *= 2.0;
-                    }
+                        double edge = locator.LocateEdge(xNext, outside->x);
+                        this->AddCompletePointToCurrentBranch(xNext, yNext);
+                        this->AddApproachToCurrentBranch(xNext, edge);
+                        this->boundaries.emplace_back(DiscontinuityLocator::Boundary{edge, outside->kind});
 
-                    this->AddCompletePointToCurrentBranch(x, y);
-                    xOld = x;
-                    yOld = y;
-                    x = x + direction(incr);
+                        return outside->kind == DiscontinuityLocator::Kind::Pole ? std::max(outside->x + this->Precision, std::nextafter(outside->x, HUGE_VAL)) : outside->x;
+                    }
                 }
-                else
+
+                if (squareDist < this->MinimumSquareDistance)
                 {
-                    incr *= 0.5;
-                    x = x - direction(incr);
+                    incr *= 2.0;
                 }
+
+                this->AddCompletePointToCurrentBranch(xNext, yNext);
+                x = xNext;
+                y = yNext;
+            }
+            else
+            {
+                incr *= 0.5;
             }
         }
+
+        return this->maxX;
     }
 
 }
@@ -22,6 +22,8 @@
 #include <memory>
 #include "expression.h"
 #include "dot.h"
+#include "cancellationtoken.h"
+#include "discontinuitylocator.h"
 
 namespace Backend {
 
@@ -37,29 +39,41 @@ namespace Backend {
         /*!
          * \brief Epsilon is the lower limit for increments etc.
          */
-        const double Epsilon = 1e-4;
+        const double Epsilon;
+
+        /*!
+         * \brief MinimumSquareDistance is the square distance between points below which the increment is enlarged.
+         */
+        const double MinimumSquareDistance;
 
         /*!
          * \brief TargetDistance is the intended upper bound for x increments, which should still be above \ref Epsilon.
          */
-        const double TargetDistance = 5e-3;
+        const double TargetDistance;
 
         /*!
          * \brief InitialIncrement is the initial increment for x.
          */
-        const double InitialIncrement = 1e-3;
+        const double InitialIncrement;
 
         /*!
          * \brief LargeIncrement is the increment to find branches.
          */
-        const double LargeIncrement = 1e-2;
+        const double LargeIncrement;
+
+        /*!
+         * \brief Precision is the width to which branch boundaries are narrowed down.
+         */
+        const double Precision;
 
         std::shared_ptr<Expression> expression;
         const double minX;
         const double maxX;
         const double limit;
+        const std::shared_ptr<CancellationToken> cancellationToken;
 
         std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData;
+        std::vector<DiscontinuityLocator::Boundary> boundaries;
 
         bool EvaluateWasCalled;
         bool AddPointToCurrentBranchAtWasCalled;
@@ -71,8 +85,10 @@ namespace Backend {
          * \param minX The minimal x to consider.
          * \param maxX The maximal x to consider.
          * \param limit The absolute value of y after which the point shall not be included in the resulting data.
+         * \param detail The factor by which the spatial resolution is refined, 1.0 being the default resolution.
+         * \param cancellationToken The optional token to stop the evaluation early, leaving a partial graph.
          */
-        Evaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit);
+        Evaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit, double detail = 1.0, std::shared_ptr<CancellationToken> cancellationToken = nullptr);
         ~Evaluator() = default;
         Evaluator(const Evaluator&) = delete;
         Evaluator& operator=(const Evaluator&) = delete;
@@ -103,11 +119,22 @@ namespace Backend {
          */
         std::vector<std::pair<std::vector<double>, std::vector<double>>> GetGraph();
 
+        /*!
+         * \brief GetBoundaries gets the located boundaries between which the branches lie.
+         * \return The boundaries in ascending order of x, excluding the ends of the window.
+         *
+         * Provided for production purposes. Only meaningful after Evaluate().
+         */
+        std::vector<DiscontinuityLocator::Boundary> GetBoundaries() const;
+
     private:
         void CreateGraph();
+        bool IsCancelled() const;
         void AddCompletePointToCurrentBranch(double x, double y);
         void EnsureAtLeastOneBranch();
-        void WorkAnInterval(double (*direction)(double), double& x, double xInCurrentInterval, double& xOld);
+        double WorkAnInterval(const DiscontinuityLocator& locator, double start, bool steepStart);
+        std::optional<DiscontinuityLocator::Boundary> FindOutside(const DiscontinuityLocator& locator, double x, double y, double probe) const;
+        void AddApproachToCurrentBranch(double x, double edge);
     };
 
 }
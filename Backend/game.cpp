@@ -19,10 +19,14 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <limits>
+#include <cmath>
 
 #include "game.h"
 #include "evaluator.h"
+#include "progressiveevaluator.h"
 #include "randomdotgenerator.h"
+#include "hitscore.h"
 
 namespace Backend {
 
@@ -32,22 +36,271 @@ namespace Backend {
         this->Clear();
     }
 
-    Game::Game(std::shared_ptr<DotGenerator> dotGenerator, std::shared_ptr<Repository> repository)
-        : dotGenerator(dotGenerator),
-          repository(repository)
+    Game::Game(std::shared_ptr<DotGenerator> dotGenerator, std::shared_ptr<Repository> repository, unsigned int threadCount, unsigned long int functionLimit, const BoardSpec & boardSpec)
+        : boardSpec(boardSpec),
+          dotGenerator(dotGenerator),
+          repository(repository),
+          functionLimit(functionLimit),
+          hitWordCount((functionLimit + 63) / 64),
+          graphTileCache(std::make_shared<GraphTileCache>(boardSpec.GetLimit(), GraphTileCache::DefaultCapacity, boardSpec.GetMinX(), boardSpec.GetMaxX())),
+          dotGrid(std::make_shared<DotGrid>(std::vector<std::shared_ptr<Dot>>())),
+          dotSet(std::make_shared<DotSet>(std::vector<std::shared_ptr<Dot>>())),
+          threadPool(std::make_shared<ThreadPool>(threadCount))
     {
+        if(functionLimit == 0)
+        {
+            throw std::exception("a game needs to allow functions");
+        }
+
         this->Init();
     }
 
+    Game::Game(const BoardSpec & boardSpec, std::shared_ptr<Repository> repository, unsigned int threadCount, unsigned long int functionLimit)
+        : Game(std::make_shared<RandomDotGenerator>(boardSpec), repository, threadCount, functionLimit, boardSpec)
+    {
+    }
+
     void Game::Remake()
     {
         this->Init();
     }
 
-    void Game::Update(const std::vector<std::wstring> & funcStrings)
+    GameChangeSet Game::Update(const std::vector<std::wstring> & funcStrings, std::shared_ptr<CancellationToken> cancellationToken, std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress)
     {
+        auto previous = this->GetSnapshot();
         this->updateFuncStrings = funcStrings;
-        this->CreateGraphs();
+        this->CreateGraphs(cancellationToken, progress);
+
+        return this->GetSnapshot()->GetChangesSince(*previous);
+    }
+
+    GameChangeSet Game::Restore(const GameSnapshot & snapshot)
+    {
+        auto previous = this->GetSnapshot();
+        auto & restoredDots = snapshot.GetDots();
+
+        auto isSameDot = [](const std::shared_ptr<Dot> & dot, const std::shared_ptr<const Dot> & restoredDot)
+        {
+            return dot->GetCoordinates() == restoredDot->GetCoordinates() && dot->GetRadius() == restoredDot->GetRadius() && dot->IsGood() == restoredDot->IsGood();
+        };
+
+        // the hits in the slots refer to the dots by index
+        if(!std::equal(this->dots.begin(), this->dots.end(), restoredDots.begin(), restoredDots.end(), isSameDot))
+        {
+            std::vector<std::shared_ptr<Dot>> copies;
+            for(auto & restoredDot : restoredDots)
+            {
+                auto coordinates = restoredDot->GetCoordinates();
+                copies.emplace_back(std::make_shared<Dot>(coordinates.first, coordinates.second, restoredDot->IsGood(), restoredDot->GetRadius()));
+            }
+
+            this->dots = copies;
+            this->ResizeHits();
+            this->dotGrid = std::make_shared<DotGrid>(this->dots, this->boardSpec.GetLatticeSpacing());
+            this->dotSet = std::make_shared<DotSet>(this->dots);
+            this->publishedDots.reset();
+        }
+
+        this->updateFuncStrings = snapshot.GetFunctions();
+        this->slots = snapshot.GetSlots();
+        this->ApplyHits();
+        this->PublishSnapshot();
+
+        return this->GetSnapshot()->GetChangesSince(*previous);
+    }
+
+    std::shared_ptr<const GameSnapshot> Game::EvaluateWhatIf(unsigned long int index, const std::wstring & funcString, std::shared_ptr<CancellationToken> cancellationToken) const
+    {
+        if(index >= this->functionLimit)
+        {
+            throw std::exception("what-if slot is beyond the function limit");
+        }
+
+        auto funcStrings = this->updateFuncStrings;
+        if(funcStrings.size() < index + 1)
+        {
+            funcStrings.resize(index + 1);
+        }
+
+        funcStrings[index] = funcString;
+
+        // every other slot is shared as it is
+        auto whatIfSlots = this->slots;
+        auto expression = this->EvaluateSlot(index, funcString, whatIfSlots, cancellationToken, nullptr);
+        if(expression && !(cancellationToken && cancellationToken->IsCancelled()) && !whatIfSlots[index]->IsCheckedFor(funcString))
+        {
+            this->CheckDots({ std::make_pair(index, expression) }, whatIfSlots, cancellationToken);
+        }
+
+        if(cancellationToken && cancellationToken->IsCancelled())
+        {
+            return nullptr;
+        }
+
+        auto hitBy = this->CollectHits(funcStrings, whatIfSlots);
+        auto whatIfDots = std::make_shared<std::vector<std::shared_ptr<const Dot>>>();
+        bool isBadDotHit = false;
+
+        for(size_t dotIndex = 0; dotIndex < this->dots.size(); ++dotIndex)
+        {
+            auto row = hitBy.begin() + static_cast<std::ptrdiff_t>(dotIndex * this->hitWordCount);
+            bool isActive = std::any_of(row, row + static_cast<std::ptrdiff_t>(this->hitWordCount), [](std::uint64_t word){ return word != 0; });
+
+            Dot dot(*this->dots[dotIndex]);
+            dot.SetIsActive(isActive);
+            whatIfDots->emplace_back(std::make_shared<const Dot>(dot));
+
+            isBadDotHit = isBadDotHit || (isActive && !dot.IsGood());
+        }
+
+        auto score = isBadDotHit ? -1 : GetHitScore(hitBy, this->hitWordCount);
+
+        return std::make_shared<const GameSnapshot>(funcStrings, whatIfSlots, whatIfDots, score);
+    }
+
+    Game::ScoreReport Game::UpdateScoreOnly(const std::vector<std::wstring> & funcStrings, std::shared_ptr<CancellationToken> cancellationToken)
+    {
+        auto isCancelled = [&]()
+        {
+            return cancellationToken && cancellationToken->IsCancelled();
+        };
+
+        std::vector<std::pair<unsigned long int, std::shared_ptr<Expression>>> functions;
+        for(unsigned long int i=0; i < funcStrings.size() && i < functionLimit; ++i)
+        {
+            auto expression = funcStrings[i].empty() ? nullptr : parser.Parse(funcStrings[i]);
+            if(expression)
+            {
+                functions.emplace_back(i, expression);
+            }
+        }
+
+        auto needsEvaluation = [&](const std::pair<unsigned long int, std::shared_ptr<Expression>> & function)
+        {
+            return slots.size() <= function.first || slots[function.first]->GetEvaluatedFunction() != funcStrings[function.first];
+        };
+
+        ScoreReport report{ 0, 0, 0, 0, 0, false };
+        auto toEvaluate = static_cast<unsigned long int>(std::count_if(functions.begin(), functions.end(), needsEvaluation));
+        auto goodDots = static_cast<unsigned long int>(std::count_if(dots.begin(), dots.end(), [](auto dot){ return dot->IsGood(); }));
+
+        std::vector<size_t> badDotIndices;
+        for(size_t dotIndex = 0; dotIndex < this->dots.size(); ++dotIndex)
+        {
+            if(!this->dots[dotIndex]->IsGood())
+            {
+                badDotIndices.emplace_back(dotIndex);
+            }
+        }
+
+        // a single bad dot decides the score, so the bad dots are probed first at their center and edges all at once,
+        // and only if none is hit there, the graph across each of them is evaluated
+        auto hit = std::make_pair(this->dots.size(), 0UL);
+
+        for(auto & function : functions)
+        {
+            if(isCancelled() || hit.first < this->dots.size())
+            {
+                break;
+            }
+
+            std::vector<std::pair<std::vector<double>, std::vector<double>>> probes(1);
+            for(auto dotIndex : badDotIndices)
+            {
+                auto x = this->dots[dotIndex]->GetCoordinates().first;
+                auto r = this->dots[dotIndex]->GetRadius();
+
+                for(auto probeX : { x - r, x, x + r })
+                {
+                    auto probeY = function.second->Evaluate(probeX);
+                    if(probeY && std::isfinite(probeY.value()))
+                    {
+                        probes[0].first.emplace_back(probeX);
+                        probes[0].second.emplace_back(probeY.value());
+                    }
+                }
+            }
+
+            auto isHitByProbes = this->dotSet->FindDotsHitBySamples(probes);
+            auto probed = std::find_if(badDotIndices.begin(), badDotIndices.end(), [&](size_t dotIndex){ return isHitByProbes[dotIndex]; });
+            if(probed != badDotIndices.end())
+            {
+                hit = std::make_pair(*probed, function.first);
+            }
+        }
+
+        for(auto dotIndex : badDotIndices)
+        {
+            if(isCancelled() || hit.first < this->dots.size())
+            {
+                break;
+            }
+
+            auto dot = this->dots[dotIndex];
+            auto x = dot->GetCoordinates().first;
+
+            for(auto & function : functions)
+            {
+                Evaluator evaluator(function.second, x - dot->GetRadius(), x + dot->GetRadius(), this->boardSpec.GetLimit(), 1.0, cancellationToken);
+                auto graph = evaluator.Evaluate();
+                ++report.windowsEvaluated;
+
+                if(isCancelled())
+                {
+                    break;
+                }
+
+                if(dot->IsHitBy(function.second, graph, cancellationToken))
+                {
+                    hit = std::make_pair(dotIndex, function.first);
+                    break;
+                }
+            }
+        }
+
+        // the game is left as it was rather than holding functions without their graphs
+        if(isCancelled())
+        {
+            report.isCancelled = true;
+            return report;
+        }
+
+        this->updateFuncStrings = funcStrings;
+
+        if(hit.first < this->dots.size())
+        {
+            // the graphs of changed functions are not evaluated, so they are published empty instead of showing the old functions
+            for(unsigned long int i=0; i < updateFuncStrings.size() && i < functionLimit; ++i)
+            {
+                if(this->slots.size() < i + 1)
+                {
+                    this->slots.resize(i + 1, GameSlot::GetEmpty());
+                }
+
+                if(this->slots[i]->GetEvaluatedFunction() != updateFuncStrings[i])
+                {
+                    this->slots[i] = GameSlot::GetEmpty();
+                }
+            }
+
+            // the unchanged functions keep their hits
+            this->ApplyHits();
+            this->dots[hit.first]->SetIsActive(true);
+            this->MarkHit(hit.first, hit.second);
+
+            report.score = -1;
+            report.functionsSkipped = toEvaluate;
+            report.dotChecksSkipped = static_cast<unsigned long int>(functions.size()) * goodDots;
+            this->PublishSnapshot();
+            return report;
+        }
+
+        this->CreateGraphs(cancellationToken);
+
+        report.score = this->GetScore();
+        report.functionsEvaluated = toEvaluate;
+        report.isCancelled = isCancelled();
+        return report;
     }
 
     bool Game::IsParseable(const std::wstring& input) const
@@ -55,19 +308,65 @@ namespace Backend {
         return this->parser.IsParseable(input);
     }
 
+    std::shared_ptr<const GameSnapshot> Game::GetSnapshot() const
+    {
+        return std::atomic_load(&this->snapshot);
+    }
+
+    unsigned long int Game::GetFunctionLimit() const
+    {
+        return functionLimit;
+    }
+
+    const BoardSpec & Game::GetBoardSpec() const
+    {
+        return this->boardSpec;
+    }
+
     const std::vector<std::wstring> Game::GetFunctions() const
     {
         return this->updateFuncStrings;
     }
 
-    const std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>>& Game::GetGraphs() const
+    std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> Game::GetGraphs() const
     {
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> graphs;
+        for(const auto & slot : this->slots)
+        {
+            graphs.push_back(slot->GetGraph());
+        }
+
         return graphs;
     }
 
+    std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> Game::GetGraphsForViewport(double minX, double maxX)
+    {
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> viewportGraphs;
+
+        for(unsigned long int i=0; i < slots.size() && i < updateFuncStrings.size(); ++i)
+        {
+            auto expression = updateFuncStrings[i].empty() ? nullptr : parser.Parse(updateFuncStrings[i]);
+            if(!expression)
+            {
+                viewportGraphs.emplace_back(std::vector<std::pair<std::vector<double>, std::vector<double>>>());
+                continue;
+            }
+
+            viewportGraphs.emplace_back(this->graphTileCache->GetGraph(expression, minX, maxX));
+        }
+
+        return viewportGraphs;
+    }
+
     void Game::SetDots(std::vector<std::shared_ptr<Dot>> newDots)
     {
         dots = newDots;
+        ResizeHits();
+        ClearHits();
+        dotGrid = std::make_shared<DotGrid>(dots, boardSpec.GetLatticeSpacing());
+        dotSet = std::make_shared<DotSet>(dots);
+        publishedDots.reset();
+        PublishSnapshot();
     }
 
     const std::vector<std::shared_ptr<Dot>>& Game::GetDots() const
@@ -82,49 +381,25 @@ namespace Backend {
             return -1;
         }
 
-        int score(0);
-
-        std::vector<std::set<unsigned long int>> copy(this->dotHitBy);
+        return GetHitScore(this->dotHitBy, this->hitWordCount);
+    }
 
-        while(std::any_of(copy.begin(), copy.end(), [&](std::set<unsigned long int> set){ return !set.empty(); }))
+    double Game::GetMargin(unsigned long int functionIndex, size_t dotIndex) const
+    {
+        if(functionIndex >= this->functionLimit || dotIndex >= this->dots.size())
         {
-            std::vector<int> counts;
-
-            std::for_each(copy.begin(), copy.end(), [&](std::set<unsigned long int> set)
-            {
-                std::for_each(set.begin(), set.end(), [&](unsigned long int index)
-                {
-                    while(counts.size() <= index)
-                    {
-                        counts.push_back(0);
-                    }
-
-                    ++counts[index];
-                });
-            });
-
-            auto index = static_cast<unsigned long int>(distance(counts.begin(), std::max_element(counts.begin(), counts.end())));
-
-            score += static_cast<int>(std::pow(2, counts[index])) - 1;
-
-            std::for_each(copy.begin(), copy.end(), [&](std::set<unsigned long int> & set)
-            {
-                if(set.find(index) != set.end())
-                {
-                    set.clear();
-                }
-            });
+            return std::numeric_limits<double>::infinity();
         }
 
-        return score;
+        return this->dotMargins[dotIndex * this->functionLimit + functionIndex];
     }
 
     void Game::Clear()
     {
         this->updateFuncStrings.clear();
-        this->funcStringsEvaluated.clear();
-        this->graphs.clear();
+        this->slots.clear();
         this->ResetDots();
+        this->PublishSnapshot();
     }
 
     std::pair<bool, std::wstring> Game::Save(std::wstring identifier) const
@@ -143,88 +418,276 @@ namespace Backend {
         this->CreateDots();
     }
 
-    void Game::CreateGraphs()
+    void Game::CreateGraphs(std::shared_ptr<CancellationToken> cancellationToken, std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress)
     {
-        this->ResetDots();
+        auto isCancelled = [&]()
+        {
+            return cancellationToken && cancellationToken->IsCancelled();
+        };
 
-        for(unsigned long int i=0; i < updateFuncStrings.size() && i < 5; ++i)
+        std::vector<std::pair<unsigned long int, std::shared_ptr<Expression>>> functionsToCheck;
+
+        for(unsigned long int i=0; i < updateFuncStrings.size() && i < functionLimit; ++i)
         {
-            if(updateFuncStrings[i].empty())
+            if(isCancelled())
             {
-                this->PutEmptyGraphAtIndex(i);
-                this->SaveFunctionAtIndex(i, updateFuncStrings[i]);
-                continue;
+                break;
             }
 
 #ifdef _DEBUG
             if(updateFuncStrings[i] == L"slow")
             {
-                std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+                for(int slept = 0; slept < 2000 && !isCancelled(); slept += 10)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
                 continue;
             }
 #endif
 
-            auto expression = parser.Parse(updateFuncStrings[i]);
-            if(!expression)
+            auto expression = this->EvaluateSlot(i, updateFuncStrings[i], this->slots, cancellationToken, progress);
+
+            // a partial graph must not be checked
+            if(isCancelled())
             {
-                this->PutEmptyGraphAtIndex(i);
-                continue;
+                break;
             }
 
-            if(funcStringsEvaluated.size() <= i || funcStringsEvaluated[i] != updateFuncStrings[i])
+            // the hits of unchanged functions are still known
+            if(expression && !this->slots[i]->IsCheckedFor(updateFuncStrings[i]))
             {
-                Evaluator evaluator(expression, -10.5, 10.5, 1000.0);
-                auto graph = evaluator.Evaluate();
-                this->PutGraphAtIndex(i, graph);
-                this->SaveFunctionAtIndex(i, updateFuncStrings[i]);
+                functionsToCheck.emplace_back(i, expression);
             }
+        }
 
-            this->CheckDots(i, expression, this->graphs[i]);
+        this->CheckDots(functionsToCheck, this->slots, cancellationToken);
+        this->ApplyHits();
+        this->PublishSnapshot();
+    }
+
+    std::shared_ptr<Expression> Game::EvaluateSlot(unsigned long int index,
+                                                   const std::wstring & funcString,
+                                                   std::vector<std::shared_ptr<const GameSlot>> & slots,
+                                                   std::shared_ptr<CancellationToken> cancellationToken,
+                                                   std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress) const
+    {
+        if(slots.size() < index + 1)
+        {
+            slots.resize(index + 1, GameSlot::GetEmpty());
+        }
+
+        auto publish = [&]()
+        {
+            if(progress)
+            {
+                progress(index, slots[index]->GetGraphHandle());
+            }
+        };
+
+        auto expression = funcString.empty() ? nullptr : this->parser.Parse(funcString);
+        if(!expression)
+        {
+            slots[index] = GameSlot::GetEmpty();
+            publish();
+            return nullptr;
+        }
+
+        if(slots[index]->GetEvaluatedFunction() == funcString)
+        {
+            publish();
+            return expression;
+        }
+
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> graph;
+
+        if(progress)
+        {
+            ProgressiveEvaluator evaluator(expression, this->boardSpec.GetMinX(), this->boardSpec.GetMaxX(), this->boardSpec.GetLimit(), cancellationToken);
+            graph = evaluator.Evaluate([&](std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> snapshot){ progress(index, snapshot); });
+        }
+        else
+        {
+            Evaluator evaluator(expression, this->boardSpec.GetMinX(), this->boardSpec.GetMaxX(), this->boardSpec.GetLimit(), 1.0, cancellationToken);
+            graph = evaluator.Evaluate();
         }
+
+        // a partial graph is shown, but must be evaluated again next time
+        auto isComplete = !(cancellationToken && cancellationToken->IsCancelled());
+        slots[index] = std::make_shared<const GameSlot>(isComplete ? funcString : std::wstring(),
+                                                        std::make_shared<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>(std::move(graph)));
+
+        return expression;
     }
 
-    void Game::PutEmptyGraphAtIndex(unsigned long int index)
+    void Game::CreateDots()
     {
-        this->PutGraphAtIndex(index, std::vector<std::pair<std::vector<double>, std::vector<double>>>());
+        this->dots = this->dotGenerator->Generate();
+        this->ResizeHits();
+        this->ClearHits();
+        this->dotGrid = std::make_shared<DotGrid>(this->dots, this->boardSpec.GetLatticeSpacing());
+        this->dotSet = std::make_shared<DotSet>(this->dots);
+        this->publishedDots.reset();
+        this->PublishSnapshot();
     }
 
-    void Game::PutGraphAtIndex(unsigned long int index, std::vector<std::pair<std::vector<double>, std::vector<double>>> graph)
+    void Game::CheckDots(const std::vector<std::pair<unsigned long int, std::shared_ptr<Expression>>> & functions,
+                         std::vector<std::shared_ptr<const GameSlot>> & slots,
+                         std::shared_ptr<CancellationToken> cancellationToken) const
     {
-        while(this->graphs.size() < index + 1)
+        auto isCancelled = [&]()
+        {
+            return cancellationToken && cancellationToken->IsCancelled();
+        };
+
+        // one pass over the samples settles most hits, the remaining dots near a graph need a closer look
+        // and measures the margins on the way
+        std::vector<std::vector<bool>> isHitBySamples(functions.size());
+        std::vector<std::vector<double>> closestSquareDistances(functions.size());
+        std::vector<std::vector<size_t>> candidates(functions.size());
+
+        this->threadPool->ForEach(functions.size(), [&](size_t f)
+        {
+            const auto & graphData = slots[functions[f].first]->GetGraph();
+            isHitBySamples[f] = this->dotSet->FindDotsHitBySamples(graphData, closestSquareDistances[f]);
+            candidates[f] = this->dotGrid->GetCandidates(graphData);
+        });
+
+        // each cell of the function x dot matrix is independent and writes only its own result
+        std::vector<std::pair<size_t, size_t>> cells;
+        for(size_t f = 0; f < functions.size(); ++f)
+        {
+            for(auto dotIndex : candidates[f])
+            {
+                if(!isHitBySamples[f][dotIndex])
+                {
+                    cells.emplace_back(f, dotIndex);
+                }
+            }
+        }
+
+        std::vector<char> isHit(cells.size(), 0);
+
+        this->threadPool->ForEach(cells.size(), [&](size_t c)
         {
-            this->graphs.push_back(std::vector<std::pair<std::vector<double>, std::vector<double>>>());
+            if(isCancelled())
+            {
+                return;
+            }
+
+            auto & function = functions[cells[c].first];
+            isHit[c] = this->dots[cells[c].second]->IsHitBy(function.second, slots[function.first]->GetGraph(), cancellationToken) ? 1 : 0;
+        });
+
+        // partial results must not be kept
+        if(isCancelled())
+        {
+            return;
         }
 
-        this->graphs[index] = graph;
+        std::vector<std::vector<size_t>> dotIndices(functions.size());
+        for(size_t c = 0; c < cells.size(); ++c)
+        {
+            if(isHit[c])
+            {
+                dotIndices[cells[c].first].emplace_back(cells[c].second);
+            }
+        }
+
+        for(size_t f = 0; f < functions.size(); ++f)
+        {
+            for(auto dotIndex : candidates[f])
+            {
+                if(isHitBySamples[f][dotIndex])
+                {
+                    dotIndices[f].emplace_back(dotIndex);
+                }
+            }
+
+            std::sort(dotIndices[f].begin(), dotIndices[f].end());
+
+            std::vector<float> margins(this->dots.size());
+            for(size_t dotIndex = 0; dotIndex < this->dots.size(); ++dotIndex)
+            {
+                margins[dotIndex] = static_cast<float>(std::sqrt(closestSquareDistances[f][dotIndex]));
+            }
+
+            // a hit found between the samples is closer than the chords tell
+            for(auto dotIndex : dotIndices[f])
+            {
+                margins[dotIndex] = std::min(margins[dotIndex], static_cast<float>(this->dots[dotIndex]->GetRadius()));
+            }
+
+            auto & slot = slots[functions[f].first];
+            slot = slot->WithHits(slot->GetEvaluatedFunction(), std::move(dotIndices[f]), std::move(margins));
+        }
     }
 
-    void Game::SaveFunctionAtIndex(unsigned long int index, std::wstring funcString)
+    void Game::ClearHits()
     {
-        while(this->funcStringsEvaluated.size() < index + 1)
+        // the graphs stay valid for other dots
+        for(auto & slot : this->slots)
         {
-            this->funcStringsEvaluated.emplace_back(L"");
+            slot = std::make_shared<const GameSlot>(slot->GetEvaluatedFunction(), slot->GetGraphHandle());
         }
+    }
 
-        this->funcStringsEvaluated[index] = funcString;
+    void Game::ResizeHits()
+    {
+        // one row of bits and one row of margins per dot
+        this->dotHitBy = std::vector<std::uint64_t>(this->dots.size() * this->hitWordCount, 0);
+        this->dotMargins = std::vector<float>(this->dots.size() * this->functionLimit, std::numeric_limits<float>::infinity());
     }
 
-    void Game::CreateDots()
+    void Game::MarkHit(size_t dotIndex, unsigned long int functionIndex)
     {
-        this->dots = this->dotGenerator->Generate();
-        this->dotHitBy = std::vector<std::set<unsigned long int>>(this->dots.size());
+        this->dotHitBy[dotIndex * this->hitWordCount + functionIndex / 64] |= std::uint64_t(1) << (functionIndex % 64);
     }
 
-    void Game::CheckDots(unsigned long int graphIndex, std::shared_ptr<Expression> expression, std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData)
+    std::vector<std::uint64_t> Game::CollectHits(const std::vector<std::wstring> & funcStrings, const std::vector<std::shared_ptr<const GameSlot>> & slots) const
     {
-        const auto dotCount = this->dots.size();
-        for(size_t dotIndex = 0; dotIndex < dotCount; ++dotIndex)
+        std::vector<std::uint64_t> hitBy(this->dots.size() * this->hitWordCount, 0);
+
+        for(unsigned long int i = 0; i < funcStrings.size() && i < slots.size() && i < this->functionLimit; ++i)
         {
-            auto & dot = this->dots[dotIndex];
+            if(!slots[i]->IsCheckedFor(funcStrings[i]))
+            {
+                continue;
+            }
+
+            for(auto dotIndex : slots[i]->GetDotsHit())
+            {
+                hitBy[dotIndex * this->hitWordCount + i / 64] |= std::uint64_t(1) << (i % 64);
+            }
+        }
+
+        return hitBy;
+    }
+
+    void Game::ApplyHits()
+    {
+        this->ResetDots();
+        this->dotHitBy = this->CollectHits(this->updateFuncStrings, this->slots);
+
+        for(size_t dotIndex = 0; dotIndex < this->dots.size(); ++dotIndex)
+        {
+            auto row = this->dotHitBy.begin() + static_cast<std::ptrdiff_t>(dotIndex * this->hitWordCount);
+            if(std::any_of(row, row + static_cast<std::ptrdiff_t>(this->hitWordCount), [](std::uint64_t word){ return word != 0; }))
+            {
+                this->dots[dotIndex]->SetIsActive(true);
+            }
+        }
 
-            bool wasHit = dot->CheckForHit(expression, graphData);
-            if(wasHit)
+        for(unsigned long int i = 0; i < this->updateFuncStrings.size() && i < this->slots.size() && i < this->functionLimit; ++i)
+        {
+            if(!this->slots[i]->IsCheckedFor(this->updateFuncStrings[i]))
+            {
+                continue;
+            }
+
+            const auto & margins = this->slots[i]->GetMargins();
+            for(size_t dotIndex = 0; dotIndex < margins.size(); ++dotIndex)
             {
-                dotHitBy[dotIndex].insert(graphIndex);
+                this->dotMargins[dotIndex * this->functionLimit + i] = margins[dotIndex];
             }
         }
     }
@@ -236,7 +699,33 @@ namespace Backend {
             (*dotIterator)->ResetIsActive();
         }
 
-        std::for_each(this->dotHitBy.begin(), this->dotHitBy.end(), [](std::set<unsigned long int> &set){ set.clear(); });
+        std::fill(this->dotHitBy.begin(), this->dotHitBy.end(), 0);
+        std::fill(this->dotMargins.begin(), this->dotMargins.end(), std::numeric_limits<float>::infinity());
+    }
+
+    void Game::PublishSnapshot()
+    {
+        // the dots are shared with the previous snapshot unless one of them flipped
+        auto areDotsPublished = this->publishedDots
+                && std::equal(this->dots.begin(), this->dots.end(), this->publishedDots->begin(), this->publishedDots->end(),
+                              [](const std::shared_ptr<Dot> & dot, const std::shared_ptr<const Dot> & publishedDot)
+        {
+            return dot->IsActive() == publishedDot->IsActive();
+        });
+
+        if(!areDotsPublished)
+        {
+            auto copies = std::make_shared<std::vector<std::shared_ptr<const Dot>>>();
+            for(auto & dot : this->dots)
+            {
+                copies->emplace_back(std::make_shared<const Dot>(*dot));
+            }
+
+            this->publishedDots = copies;
+        }
+
+        auto published = std::make_shared<const GameSnapshot>(this->updateFuncStrings, this->slots, this->publishedDots, this->GetScore());
+        std::atomic_store(&this->snapshot, published);
     }
 
 }
@@ -20,15 +20,24 @@
 #define GAME_H
 
 #include <vector>
-#include <set>
+#include <cstdint>
 #include <memory>
+#include <functional>
 #include "classes.h"
 #include "parser.h"
 #include "dot.h"
 #include "dotgenerator.h"
+#include "boardspec.h"
 #include "randomdotgenerator.h"
 #include "repository.h"
 #include "diskrepository.h"
+#include "graphtilecache.h"
+#include "dotgrid.h"
+#include "dotset.h"
+#include "cancellationtoken.h"
+#include "threadpool.h"
+#include "gameslot.h"
+#include "gamesnapshot.h"
 
 namespace Backend {
 
@@ -36,28 +45,76 @@ namespace Backend {
      * \class Game
      * \brief The Game class represents an active game.
      *        It evaluates functions into graph data and handles dots.
+     *
+     * A game is changed by one thread at a time. Other threads read the state through \ref GetSnapshot.
      */
     class Game final
     {
+    public:
+        /*!
+         * \brief DefaultFunctionLimit is the number of functions a game evaluates unless told otherwise.
+         */
+        constexpr static const unsigned long int DefaultFunctionLimit = 5;
+
+        /*!
+         * \brief The ScoreReport struct describes the outcome of a score-only update and the work it skipped.
+         */
+        struct ScoreReport
+        {
+            int score;
+            unsigned long int functionsEvaluated;
+            unsigned long int functionsSkipped;
+            unsigned long int dotChecksSkipped;
+            unsigned long int windowsEvaluated;
+            bool isCancelled;
+        };
+
     private:
         std::vector<std::shared_ptr<Dot>> dots;
         std::vector<std::wstring> updateFuncStrings;
-        std::vector<std::wstring> funcStringsEvaluated;
-        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> graphs;
+        std::vector<std::shared_ptr<const GameSlot>> slots;
 
         Parser parser;
+        BoardSpec boardSpec;
         std::shared_ptr<DotGenerator> dotGenerator;
         std::shared_ptr<Repository> repository;
-        std::vector<std::set<unsigned long int>> dotHitBy;
+        unsigned long int functionLimit;
+        size_t hitWordCount;
+        std::vector<std::uint64_t> dotHitBy;
+        std::vector<float> dotMargins;
+        std::shared_ptr<GraphTileCache> graphTileCache;
+        std::shared_ptr<DotGrid> dotGrid;
+        std::shared_ptr<DotSet> dotSet;
+        std::shared_ptr<ThreadPool> threadPool;
+        std::shared_ptr<const GameSnapshot> snapshot;
+        std::shared_ptr<const std::vector<std::shared_ptr<const Dot>>> publishedDots;
 
     public:
         /*!
          * \brief Initializes a new instance using the supplied dot generator.
          * \param dotGenerator The generator to use in creation of a new game.
          * \param repository The repository used to persist games.
+         * \param threadCount The number of threads checking the dots, 0 meaning one per core.
+         * \param functionLimit The number of functions evaluated, further ones are ignored.
+         * \param boardSpec The board whose window the graphs are evaluated in, while the dots come from the generator.
          */
         Game(std::shared_ptr<DotGenerator> dotGenerator = std::make_shared<RandomDotGenerator>(8, 2),
-             std::shared_ptr<Repository> repository = std::make_shared<DiskRepository>());
+             std::shared_ptr<Repository> repository = std::make_shared<DiskRepository>(),
+             unsigned int threadCount = 0,
+             unsigned long int functionLimit = DefaultFunctionLimit,
+             const BoardSpec & boardSpec = BoardSpec());
+
+        /*!
+         * \brief Initializes a new instance on the supplied board, with dots placed at random.
+         * \param boardSpec The board to play on.
+         * \param repository The repository used to persist games.
+         * \param threadCount The number of threads checking the dots, 0 meaning one per core.
+         * \param functionLimit The number of functions evaluated, further ones are ignored.
+         */
+        explicit Game(const BoardSpec & boardSpec,
+                      std::shared_ptr<Repository> repository = std::make_shared<DiskRepository>(),
+                      unsigned int threadCount = 0,
+                      unsigned long int functionLimit = DefaultFunctionLimit);
         ~Game() = default;
         Game(const Game&) = delete;
         Game(Game&&) = delete;
@@ -72,13 +129,53 @@ namespace Backend {
         /*!
          * \brief Evaluates the functions supplied by the user.
          * \param funcStrings The user-supplied string representations of functions.
+         * \param cancellationToken The optional token to stop the evaluation early, leaving partial or empty graphs.
+         * \param progress The optional function accepting the index and an immutable snapshot of each graph
+         *        as it is refined from coarse to fine, called on the evaluating thread.
+         * \return The changes since the state before the update.
          */
-        void Update(const std::vector<std::wstring> & funcStrings);
+        GameChangeSet Update(const std::vector<std::wstring> & funcStrings,
+                    std::shared_ptr<CancellationToken> cancellationToken = nullptr,
+                    std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress = nullptr);
+
+        /*!
+         * \brief Restores an earlier state of the game, e.g. to undo an update, without evaluating anything.
+         * \param snapshot A snapshot of this game.
+         * \return The changes since the state before the restore.
+         */
+        GameChangeSet Restore(const GameSnapshot & snapshot);
+
+        /*!
+         * \brief Evaluates what the game would be like with one function replaced, leaving the game unchanged.
+         *        The other slots are shared with the game, so only the replaced function is evaluated and checked.
+         * \param index The index of the function to replace, which must be less than the function limit.
+         * \param funcString The user-supplied string representation of the replacement.
+         * \param cancellationToken The optional token to stop the evaluation early.
+         * \return The snapshot of the hypothetical game, which may be restored to accept it, or null if cancelled.
+         */
+        std::shared_ptr<const GameSnapshot> EvaluateWhatIf(unsigned long int index,
+                                                           const std::wstring & funcString,
+                                                           std::shared_ptr<CancellationToken> cancellationToken = nullptr) const;
+
+        /*!
+         * \brief Evaluates the functions supplied by the user only as far as needed for the score.
+         *        The bad dots are probed first at a few points each, then checked against graphs of their surroundings.
+         *        If one is hit, the whole graphs and the good dots are skipped and the changed functions are published without graphs.
+         * \param funcStrings The user-supplied string representations of functions.
+         * \param cancellationToken The optional token to stop the evaluation early, leaving the game as it was if no bad dot was decided yet.
+         * \return The score, the number of function evaluations and dot checks skipped, the number of graphs evaluated around bad dots,
+         *         and whether the update was cancelled, in which case the score does not reflect the functions.
+         */
+        ScoreReport UpdateScoreOnly(const std::vector<std::wstring> & funcStrings, std::shared_ptr<CancellationToken> cancellationToken = nullptr);
 
         /*!
          * \brief CreateGraphs Creates graphs from the contained functions.
+         * \param cancellationToken The optional token to stop the evaluation early, leaving partial or empty graphs.
+         * \param progress The optional function accepting the index and an immutable snapshot of each graph
+         *        as it is refined from coarse to fine, called on the evaluating thread.
          */
-        void CreateGraphs();
+        void CreateGraphs(std::shared_ptr<CancellationToken> cancellationToken = nullptr,
+                          std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress = nullptr);
 
         /*!
          * \brief IsParseable indicates whether the supplied string can parse to an expression.
@@ -87,6 +184,24 @@ namespace Backend {
          */
         bool IsParseable(const std::wstring & input) const;
 
+        /*!
+         * \brief Gets the state published after the latest change of the game, safe to call from any thread.
+         * \return The immutable snapshot, which stays valid while the game changes further.
+         */
+        std::shared_ptr<const GameSnapshot> GetSnapshot() const;
+
+        /*!
+         * \brief Gets the number of functions evaluated.
+         * \return The function limit.
+         */
+        unsigned long int GetFunctionLimit() const;
+
+        /*!
+         * \brief Gets the board of the game.
+         * \return The board.
+         */
+        const BoardSpec & GetBoardSpec() const;
+
         /*!
          * \brief Gets the functions contained.
          * \return The functions.
@@ -94,10 +209,20 @@ namespace Backend {
         const std::vector<std::wstring> GetFunctions() const;
 
         /*!
-         * \brief Gets the sorted data calculated in the update representing the graphs of the functions.
+         * \brief Gets a copy of the sorted data calculated in the update representing the graphs of the functions.
+         *        The snapshot gives access without the copy.
          * \return The graph data in a graph.branch.(xy).data-coordinate hierarchy.
          */
-        const std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>>& GetGraphs() const;
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> GetGraphs() const;
+
+        /*!
+         * \brief Gets the graphs of the functions evaluated for the supplied viewport at a matching level of detail.
+         *        Only the parts of the graphs not already cached are evaluated.
+         * \param minX The minimal x of the viewport.
+         * \param maxX The maximal x of the viewport.
+         * \return The graph data in a graph.branch.(xy).data-coordinate hierarchy.
+         */
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> GetGraphsForViewport(double minX, double maxX);
 
         /*!
          * \brief Sets the dot information.
@@ -112,11 +237,21 @@ namespace Backend {
         const std::vector<std::shared_ptr<Dot>>& GetDots() const;
 
         /*!
-         * \brief Gets the score from the dot hitting.
+         * \brief Gets the score from the dot hitting, assigning the dots hit by several functions optimally
+         *        unless too many functions hit dots, greedily then.
          * \return The score, negative if a bad dot was hit.
          */
         int GetScore() const;
 
+        /*!
+         * \brief Gets how close the graph of a function came to the center of a dot, as found while checking the dots.
+         *        The distance is measured to the chords between the samples of the graph and at most the radius if the dot was hit.
+         * \param functionIndex The index of the function.
+         * \param dotIndex The index of the dot.
+         * \return The distance, infinity if there is no such graph or dot.
+         */
+        double GetMargin(unsigned long int functionIndex, size_t dotIndex) const;
+
         /*!
          * \brief Clears all input of the game.
          */
@@ -139,12 +274,22 @@ namespace Backend {
     private:
         void Init();
         void CreateItems();
-        void PutEmptyGraphAtIndex(unsigned long int index);
-        void PutGraphAtIndex(unsigned long index, std::vector<std::pair<std::vector<double>, std::vector<double> > > graph);
-        void SaveFunctionAtIndex(unsigned long index, std::wstring funcString);
         void CreateDots();
-        void CheckDots(unsigned long int graphIndex, std::shared_ptr<Expression> expression, std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData);
+        std::shared_ptr<Expression> EvaluateSlot(unsigned long int index,
+                                                 const std::wstring & funcString,
+                                                 std::vector<std::shared_ptr<const GameSlot>> & slots,
+                                                 std::shared_ptr<CancellationToken> cancellationToken,
+                                                 std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress) const;
+        void ClearHits();
+        void ResizeHits();
+        void MarkHit(size_t dotIndex, unsigned long int functionIndex);
+        std::vector<std::uint64_t> CollectHits(const std::vector<std::wstring> & funcStrings, const std::vector<std::shared_ptr<const GameSlot>> & slots) const;
+        void ApplyHits();
+        void CheckDots(const std::vector<std::pair<unsigned long int, std::shared_ptr<Expression>>> & functions,
+                       std::vector<std::shared_ptr<const GameSlot>> & slots,
+                       std::shared_ptr<CancellationToken> cancellationToken) const;
         void ResetDots();
+        void PublishSnapshot();
     };
 
 }
@@ -0,0 +1,87 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gameslot.h"
+
+namespace Backend {
+
+    namespace
+    {
+        const std::vector<size_t> NoDotsHit;
+        const std::vector<float> NoMargins;
+    }
+
+    GameSlot::GameSlot(std::wstring evaluatedFunction,
+                       std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> graph,
+                       std::wstring checkedFunction,
+                       std::shared_ptr<const std::vector<size_t>> dotsHit,
+                       std::shared_ptr<const std::vector<float>> margins)
+        : evaluatedFunction(std::move(evaluatedFunction)),
+          graph(graph ? graph : std::make_shared<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>()),
+          checkedFunction(std::move(checkedFunction)),
+          dotsHit(std::move(dotsHit)),
+          margins(std::move(margins))
+    {
+    }
+
+    /* static class member */ std::shared_ptr<const GameSlot> GameSlot::GetEmpty()
+    {
+        static const std::shared_ptr<const GameSlot> empty = std::make_shared<const GameSlot>(L"", nullptr);
+        return empty;
+    }
+
+    std::shared_ptr<const GameSlot> GameSlot::WithHits(const std::wstring & function, std::vector<size_t> dotsHit, std::vector<float> margins) const
+    {
+        return std::make_shared<const GameSlot>(this->evaluatedFunction,
+                                                this->graph,
+                                                function,
+                                                std::make_shared<const std::vector<size_t>>(std::move(dotsHit)),
+                                                std::make_shared<const std::vector<float>>(std::move(margins)));
+    }
+
+    const std::wstring & GameSlot::GetEvaluatedFunction() const
+    {
+        return this->evaluatedFunction;
+    }
+
+    const std::vector<std::pair<std::vector<double>, std::vector<double>>> & GameSlot::GetGraph() const
+    {
+        return *this->graph;
+    }
+
+    const std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> & GameSlot::GetGraphHandle() const
+    {
+        return this->graph;
+    }
+
+    bool GameSlot::IsCheckedFor(const std::wstring & function) const
+    {
+        return this->dotsHit && !function.empty() && this->checkedFunction == function;
+    }
+
+    const std::vector<size_t> & GameSlot::GetDotsHit() const
+    {
+        return this->dotsHit ? *this->dotsHit : NoDotsHit;
+    }
+
+    const std::vector<float> & GameSlot::GetMargins() const
+    {
+        return this->margins ? *this->margins : NoMargins;
+    }
+
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GAMESLOT_H
+#define GAMESLOT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace Backend {
+
+    /*!
+     * \class GameSlot
+     * \brief The GameSlot class holds the immutable results of one function slot of a game:
+     *        the graph of a function and the dots hit by it.
+     *
+     * A game and its snapshots share slots and their graphs, so keeping a state of a game around costs one handle per slot.
+     * Changing a slot creates a new one, reusing whatever part is still valid.
+     */
+    class GameSlot final
+    {
+    private:
+        const std::wstring evaluatedFunction;
+        const std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> graph;
+        const std::wstring checkedFunction;
+        const std::shared_ptr<const std::vector<size_t>> dotsHit;
+        const std::shared_ptr<const std::vector<float>> margins;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param evaluatedFunction The function the graph is complete for, empty if the graph is empty or partial.
+         * \param graph The graph.
+         * \param checkedFunction The function the hits were found for, empty if the dots have not been checked.
+         * \param dotsHit The indices of the dots hit, in ascending order.
+         * \param margins The distance of the graph to each dot.
+         */
+        GameSlot(std::wstring evaluatedFunction,
+                 std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> graph,
+                 std::wstring checkedFunction = std::wstring(),
+                 std::shared_ptr<const std::vector<size_t>> dotsHit = nullptr,
+                 std::shared_ptr<const std::vector<float>> margins = nullptr);
+        ~GameSlot() = default;
+        GameSlot(const GameSlot&) = delete;
+        GameSlot(GameSlot&&) = delete;
+        GameSlot& operator=(const GameSlot&) = delete;
+        GameSlot& operator=(GameSlot&&) = delete;
+
+        /*!
+         * \brief Gets the slot holding no function.
+         * \return The empty slot, shared by all games.
+         */
+        static std::shared_ptr<const GameSlot> GetEmpty();
+
+        /*!
+         * \brief WithHits creates a slot sharing the graph of this one, with the supplied hits.
+         * \param function The function the hits were found for.
+         * \param dotsHit The indices of the dots hit, in ascending order.
+         * \param margins The distance of the graph to each dot.
+         * \return The new slot.
+         */
+        std::shared_ptr<const GameSlot> WithHits(const std::wstring & function, std::vector<size_t> dotsHit, std::vector<float> margins) const;
+
+        /*!
+         * \brief Gets the function the graph is complete for.
+         * \return The function, empty if the graph is empty or partial.
+         */
+        const std::wstring & GetEvaluatedFunction() const;
+
+        /*!
+         * \brief Gets the graph.
+         * \return The graph data in a branch.(xy).data-coordinate hierarchy.
+         */
+        const std::vector<std::pair<std::vector<double>, std::vector<double>>> & GetGraph() const;
+
+        /*!
+         * \brief Gets the shared handle of the graph.
+         * \return The handle, which is never null.
+         */
+        const std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> & GetGraphHandle() const;
+
+        /*!
+         * \brief Gets a value indicating whether the hits are known for the function.
+         * \param function The function.
+         * \return true if the dots were checked against the graph of the function.
+         */
+        bool IsCheckedFor(const std::wstring & function) const;
+
+        /*!
+         * \brief Gets the indices of the dots hit.
+         * \return The indices in ascending order, empty if the dots have not been checked.
+         */
+        const std::vector<size_t> & GetDotsHit() const;
+
+        /*!
+         * \brief Gets the distance of the graph to each dot.
+         * \return The margins, empty if the dots have not been checked.
+         */
+        const std::vector<float> & GetMargins() const;
+    };
+
+}
+
+#endif // GAMESLOT_H
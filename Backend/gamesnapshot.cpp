@@ -0,0 +1,130 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gamesnapshot.h"
+
+#include <algorithm>
+
+namespace Backend {
+
+    GameSnapshot::GameSnapshot(std::vector<std::wstring> functions,
+                               std::vector<std::shared_ptr<const GameSlot>> slots,
+                               std::shared_ptr<const std::vector<std::shared_ptr<const Dot>>> dots,
+                               int score)
+        : functions(std::move(functions)),
+          slots(std::move(slots)),
+          dots(dots ? dots : std::make_shared<const std::vector<std::shared_ptr<const Dot>>>()),
+          score(score)
+    {
+    }
+
+    const std::vector<std::wstring> & GameSnapshot::GetFunctions() const
+    {
+        return this->functions;
+    }
+
+    std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> GameSnapshot::GetGraphs() const
+    {
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> graphs;
+        for(const auto & slot : this->slots)
+        {
+            graphs.push_back(slot->GetGraph());
+        }
+
+        return graphs;
+    }
+
+    size_t GameSnapshot::GetGraphCount() const
+    {
+        return this->slots.size();
+    }
+
+    const std::vector<std::pair<std::vector<double>, std::vector<double>>> & GameSnapshot::GetGraph(size_t index) const
+    {
+        return this->slots[index]->GetGraph();
+    }
+
+    const std::vector<std::shared_ptr<const GameSlot>> & GameSnapshot::GetSlots() const
+    {
+        return this->slots;
+    }
+
+    const std::vector<std::shared_ptr<const Dot>> & GameSnapshot::GetDots() const
+    {
+        return *this->dots;
+    }
+
+    int GameSnapshot::GetScore() const
+    {
+        return this->score;
+    }
+
+    GameChangeSet GameSnapshot::GetChangesSince(const GameSnapshot & previous) const
+    {
+        GameChangeSet changes{ {}, {}, false, this->score != previous.score, this->score };
+
+        // a slot missing on either side has an empty graph
+        auto graphCount = std::max(this->slots.size(), previous.slots.size());
+        auto emptySlot = GameSlot::GetEmpty();
+
+        for(unsigned long int i = 0; i < graphCount; ++i)
+        {
+            auto & graph = (i < this->slots.size() ? this->slots[i] : emptySlot)->GetGraphHandle();
+            auto & previousGraph = (i < previous.slots.size() ? previous.slots[i] : emptySlot)->GetGraphHandle();
+
+            // a shared graph is unchanged without looking at the data
+            if(graph != previousGraph && *graph != *previousGraph)
+            {
+                changes.changedGraphs.push_back(i);
+            }
+        }
+
+        // shared dots are unchanged, too
+        if(this->dots == previous.dots)
+        {
+            return changes;
+        }
+
+        auto & dots = *this->dots;
+        auto & previousDots = *previous.dots;
+        changes.areDotsReplaced = dots.size() != previousDots.size();
+
+        for(size_t i = 0; i < dots.size() && !changes.areDotsReplaced; ++i)
+        {
+            auto & dot = *dots[i];
+            auto & previousDot = *previousDots[i];
+
+            if(dot.GetCoordinates() != previousDot.GetCoordinates() || dot.GetRadius() != previousDot.GetRadius() || dot.IsGood() != previousDot.IsGood())
+            {
+                changes.areDotsReplaced = true;
+            }
+            else if(dot.IsActive() != previousDot.IsActive())
+            {
+                changes.changedDots.push_back(i);
+            }
+        }
+
+        if(changes.areDotsReplaced)
+        {
+            changes.changedDots.clear();
+        }
+
+        return changes;
+    }
+
+}
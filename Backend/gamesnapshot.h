@@ -0,0 +1,131 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "dot.h"
+#include "gameslot.h"
+
+namespace Backend {
+
+    /*!
+     * \brief The GameChangeSet struct describes what differs between two states of a game:
+     *        the function slots with other graphs, the dots whose active state flipped and the score.
+     *        If the dots themselves were replaced, their indices do not match and everything has to be redrawn.
+     */
+    struct GameChangeSet
+    {
+        std::vector<unsigned long int> changedGraphs;
+        std::vector<size_t> changedDots;
+        bool areDotsReplaced;
+        bool isScoreChanged;
+        int score;
+    };
+
+    /*!
+     * \class GameSnapshot
+     * \brief The GameSnapshot class holds the immutable state of a game as published after an update.
+     *        It can be read from any thread while the game carries on.
+     *
+     * The snapshot shares the slots with the game and with other snapshots, and the dots with the snapshots
+     * of the same dot state, so it costs a handle per slot. It can be restored into the game for undo.
+     */
+    class GameSnapshot final
+    {
+    private:
+        const std::vector<std::wstring> functions;
+        const std::vector<std::shared_ptr<const GameSlot>> slots;
+        const std::shared_ptr<const std::vector<std::shared_ptr<const Dot>>> dots;
+        const int score;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param functions The functions of the game.
+         * \param slots The slots holding the graphs of the functions.
+         * \param dots The dots of the game, which must not change afterwards.
+         * \param score The score of the game.
+         */
+        GameSnapshot(std::vector<std::wstring> functions,
+                     std::vector<std::shared_ptr<const GameSlot>> slots,
+                     std::shared_ptr<const std::vector<std::shared_ptr<const Dot>>> dots,
+                     int score);
+        ~GameSnapshot() = default;
+        GameSnapshot(const GameSnapshot&) = delete;
+        GameSnapshot(GameSnapshot&&) = delete;
+        GameSnapshot& operator=(const GameSnapshot&) = delete;
+        GameSnapshot& operator=(GameSnapshot&&) = delete;
+
+        /*!
+         * \brief Gets the functions of the game.
+         * \return The functions.
+         */
+        const std::vector<std::wstring> & GetFunctions() const;
+
+        /*!
+         * \brief Gets a copy of the graphs of the functions, see \ref GetGraph to avoid the copy.
+         * \return The graph data in a graph.branch.(xy).data-coordinate hierarchy.
+         */
+        std::vector<std::vector<std::pair<std::vector<double>, std::vector<double>>>> GetGraphs() const;
+
+        /*!
+         * \brief Gets the number of graphs.
+         * \return The count.
+         */
+        size_t GetGraphCount() const;
+
+        /*!
+         * \brief Gets the graph of a function.
+         * \param index The index of the function, which must be less than \ref GetGraphCount.
+         * \return The graph data in a branch.(xy).data-coordinate hierarchy.
+         */
+        const std::vector<std::pair<std::vector<double>, std::vector<double>>> & GetGraph(size_t index) const;
+
+        /*!
+         * \brief Gets the slots holding the graphs and hits of the functions.
+         * \return The slots.
+         */
+        const std::vector<std::shared_ptr<const GameSlot>> & GetSlots() const;
+
+        /*!
+         * \brief Gets the dots including whether they were hit.
+         * \return The dots.
+         */
+        const std::vector<std::shared_ptr<const Dot>> & GetDots() const;
+
+        /*!
+         * \brief Gets the score of the game.
+         * \return The score, negative if a bad dot was hit.
+         */
+        int GetScore() const;
+
+        /*!
+         * \brief Gets the changes from an earlier snapshot to this one.
+         * \param previous The earlier snapshot.
+         * \return The change set.
+         */
+        GameChangeSet GetChangesSince(const GameSnapshot & previous) const;
+    };
+
+}
+
+#endif // GAMESNAPSHOT_H
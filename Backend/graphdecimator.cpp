@@ -0,0 +1,101 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include "graphdecimator.h"
+
+namespace Backend {
+
+    GraphDecimator::GraphDecimator(double minX, double maxX, unsigned int columnCount)
+        : minX(minX),
+          columnWidth(columnCount == 0 ? 0.0 : (maxX - minX) / columnCount)
+    {
+        if(columnCount == 0)
+        {
+            throw std::exception("decimation needs at least one column");
+        }
+
+        if(maxX <= minX)
+        {
+            throw std::exception("decimation needs a non-empty range");
+        }
+    }
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> GraphDecimator::Decimate(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph) const
+    {
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> result;
+        result.reserve(graph.size());
+
+        for(auto & branch : graph)
+        {
+            result.emplace_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+            auto & decimated = result.back();
+
+            auto & xs = branch.first;
+            auto & ys = branch.second;
+
+            size_t runStart = 0;
+            while(runStart < xs.size())
+            {
+                // find the run of points in the same column and its extremes
+                long long column = this->ColumnOf(xs[runStart]);
+                size_t runEnd = runStart;
+                size_t lowest = runStart;
+                size_t highest = runStart;
+
+                while(runEnd < xs.size() && this->ColumnOf(xs[runEnd]) == column)
+                {
+                    if(ys[runEnd] < ys[lowest])
+                    {
+                        lowest = runEnd;
+                    }
+                    if(ys[runEnd] > ys[highest])
+                    {
+                        highest = runEnd;
+                    }
+                    ++runEnd;
+                }
+
+                // keep them in their original order, each once
+                size_t kept[] = { runStart, std::min(lowest, highest), std::max(lowest, highest), runEnd - 1 };
+                for(size_t i = 0; i < 4; ++i)
+                {
+                    if(i > 0 && kept[i] == kept[i - 1])
+                    {
+                        continue;
+                    }
+
+                    decimated.first.emplace_back(xs[kept[i]]);
+                    decimated.second.emplace_back(ys[kept[i]]);
+                }
+
+                runStart = runEnd;
+            }
+        }
+
+        return result;
+    }
+
+    long long GraphDecimator::ColumnOf(double x) const
+    {
+        return static_cast<long long>(std::floor((x - this->minX) / this->columnWidth));
+    }
+
+}
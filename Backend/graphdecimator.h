@@ -0,0 +1,67 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHDECIMATOR_H
+#define GRAPHDECIMATOR_H
+
+#include <vector>
+
+namespace Backend {
+
+    /*!
+     * \class GraphDecimator
+     * \brief The GraphDecimator class thins out graph data to what can be told apart on screen.
+     *
+     * The x axis is divided into columns as wide as a pixel. Of the consecutive points of a branch within a column,
+     * only the first, the last, the lowest and the highest are kept, so the drawn graph looks the same,
+     * but the number of points is bounded by four times the number of columns.
+     */
+    class GraphDecimator final
+    {
+    private:
+        const double minX;
+        const double columnWidth;
+
+    public:
+        /*!
+         * \brief Initializes a new instance for the given visible range and resolution.
+         * \param minX The minimal x visible.
+         * \param maxX The maximal x visible.
+         * \param columnCount The number of pixel columns between \a minX and \a maxX.
+         */
+        GraphDecimator(double minX, double maxX, unsigned int columnCount);
+        ~GraphDecimator() = default;
+        GraphDecimator(const GraphDecimator&) = delete;
+        GraphDecimator& operator=(const GraphDecimator&) = delete;
+        GraphDecimator(GraphDecimator&&) = delete;
+        GraphDecimator& operator=(GraphDecimator&&) = delete;
+
+        /*!
+         * \brief Decimate thins out each branch of the graph.
+         * \param graph The branches of the graph, sorted by x.
+         * \return The branches with at most four points per column, in the same order.
+         */
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> Decimate(const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph) const;
+
+    private:
+        long long ColumnOf(double x) const;
+    };
+
+}
+
+#endif // GRAPHDECIMATOR_H
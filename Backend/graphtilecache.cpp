@@ -0,0 +1,185 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "graphtilecache.h"
+#include "evaluator.h"
+#include "mathhelper.h"
+
+namespace Backend {
+
+    GraphTileCache::GraphTileCache(double limit, size_t capacity, double windowMinX, double windowMaxX)
+        : limit(limit),
+          capacity(capacity),
+          windowMinX(windowMinX),
+          windowMaxX(windowMaxX),
+          tilesEvaluated(0)
+    {
+        if(capacity == 0)
+        {
+            throw std::exception("capacity of zero not allowed");
+        }
+    }
+
+    /* static class member */ unsigned int GraphTileCache::LevelForViewport(double minX, double maxX)
+    {
+        double width = maxX - minX;
+        if(!(width > 0.0) || width >= HomeWidth)
+        {
+            return 0;
+        }
+
+        auto level = static_cast<unsigned int>(std::floor(std::log2(HomeWidth / width)));
+        return std::min(level, MaxLevel);
+    }
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> GraphTileCache::GetGraph(const std::shared_ptr<Expression> expression, double minX, double maxX)
+    {
+        return this->GetGraph(expression, minX, maxX, GraphTileCache::LevelForViewport(minX, maxX));
+    }
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> GraphTileCache::GetGraph(const std::shared_ptr<Expression> expression, double minX, double maxX, unsigned int level)
+    {
+        level = std::min(level, MaxLevel);
+
+        // nothing outside the window is evaluated, however wide the viewport
+        minX = std::max(minX, this->windowMinX);
+        maxX = std::min(maxX, this->windowMaxX);
+
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> graph;
+
+        if(minX < maxX)
+        {
+            auto expressionKey = expression->Print().value_or(L"");
+            auto tileWidth = GraphTileCache::GetTileWidth(level);
+            auto firstTile = std::floor(minX / tileWidth);
+            auto lastTile = std::ceil(maxX / tileWidth) - 1.0;
+
+            // tiles beyond the capacity would be evicted by the same request, and indices beyond 2^53 are not exact
+            if(lastTile - firstTile + 1.0 > static_cast<double>(this->capacity) || std::abs(firstTile) > 9007199254740992.0 || std::abs(lastTile) > 9007199254740992.0)
+            {
+                throw std::exception("viewport needs more tiles than the cache holds");
+            }
+
+            // join branches across tile borders if their ends are close, which a pole never is
+            double detail = std::pow(2.0, level);
+            double joinSquareDistance = 16.0 * 5e-3 / (detail * detail);
+
+            for(auto tileIndex = static_cast<long long>(firstTile); tileIndex <= static_cast<long long>(lastTile); ++tileIndex)
+            {
+                auto tile = this->GetTile(expression, TileKey{expressionKey, level, tileIndex});
+                GraphTileCache::AppendTile(graph, *tile, joinSquareDistance);
+            }
+        }
+
+        if(graph.empty())
+        {
+            graph.emplace_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+        }
+
+        return graph;
+    }
+
+    size_t GraphTileCache::GetTileCount() const
+    {
+        return this->index.size();
+    }
+
+    unsigned long long GraphTileCache::GetTilesEvaluated() const
+    {
+        return this->tilesEvaluated;
+    }
+
+    void GraphTileCache::Clear()
+    {
+        this->index.clear();
+        this->recentlyUsed.clear();
+    }
+
+    std::shared_ptr<const GraphTileCache::Tile> GraphTileCache::GetTile(const std::shared_ptr<Expression> & expression, const TileKey & key)
+    {
+        // expressions that cannot be printed cannot be identified, so they are not cached
+        bool isCacheable = !key.expressionKey.empty();
+
+        if(isCacheable)
+        {
+            auto found = this->index.find(key);
+            if(found != this->index.end())
+            {
+                this->recentlyUsed.splice(this->recentlyUsed.begin(), this->recentlyUsed, found->second);
+                return found->second->second;
+            }
+        }
+
+        auto tileWidth = GraphTileCache::GetTileWidth(key.level);
+        double tileMinX = static_cast<double>(key.index) * tileWidth;
+        double tileMaxX = static_cast<double>(key.index + 1) * tileWidth;
+
+        Evaluator evaluator(expression, tileMinX, tileMaxX, this->limit, std::pow(2.0, key.level));
+        auto tile = std::make_shared<const Tile>(evaluator.Evaluate());
+        ++this->tilesEvaluated;
+
+        if(!isCacheable)
+        {
+            return tile;
+        }
+
+        this->recentlyUsed.emplace_front(std::make_pair(key, tile));
+        this->index[key] = this->recentlyUsed.begin();
+
+        while(this->index.size() > this->capacity)
+        {
+            this->index.erase(this->recentlyUsed.back().first);
+            this->recentlyUsed.pop_back();
+        }
+
+        return tile;
+    }
+
+    /* static class member */ double GraphTileCache::GetTileWidth(unsigned int level)
+    {
+        return BaseTileWidth / std::pow(2.0, level);
+    }
+
+    /* static class member */ void GraphTileCache::AppendTile(std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph, const Tile & tile, double joinSquareDistance)
+    {
+        for(auto branchIt = tile.begin(); branchIt != tile.end(); ++branchIt)
+        {
+            if(branchIt->first.empty())
+            {
+                continue;
+            }
+
+            bool isContinuation = !graph.empty()
+                    && SquareDistance(graph.back().first.back(), graph.back().second.back(), branchIt->first.front(), branchIt->second.front()) <= joinSquareDistance;
+
+            if(isContinuation)
+            {
+                auto & branch = graph.back();
+                branch.first.insert(branch.first.end(), branchIt->first.begin(), branchIt->first.end());
+                branch.second.insert(branch.second.end(), branchIt->second.begin(), branchIt->second.end());
+            }
+            else
+            {
+                graph.push_back(*branchIt);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHTILECACHE_H
+#define GRAPHTILECACHE_H
+
+#include <list>
+#include <map>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class GraphTileCache
+     * \brief The GraphTileCache class evaluates functions tile by tile for a requested viewport
+     *        and keeps the tiles in a least-recently-used cache.
+     *
+     * The x axis is divided into tiles of width \ref BaseTileWidth / 2^level. Each level refines
+     * the resolution of the \ref Evaluator by a factor of two, such that zooming into a region
+     * only requires the evaluation of the tiles of the higher level covering the region.
+     */
+    class GraphTileCache final
+    {
+    public:
+        /*!
+         * \brief BaseTileWidth is the width of a tile at level 0.
+         */
+        constexpr static const double BaseTileWidth = 4.0;
+
+        /*!
+         * \brief HomeWidth is the width of the viewport that is rendered at level 0.
+         */
+        constexpr static const double HomeWidth = 21.0;
+
+        /*!
+         * \brief MaxLevel is the highest level of detail available.
+         */
+        constexpr static const unsigned int MaxLevel = 12;
+
+        /*!
+         * \brief DefaultCapacity is the number of tiles held unless configured otherwise.
+         */
+        constexpr static const size_t DefaultCapacity = 512;
+
+    private:
+        /*!
+         * \brief The TileKey struct identifies a tile by expression, level and index along the x axis.
+         */
+        struct TileKey
+        {
+            std::wstring expressionKey;
+            unsigned int level;
+            long long index;
+
+            bool operator<(const TileKey & other) const
+            {
+                return std::tie(expressionKey, level, index) < std::tie(other.expressionKey, other.level, other.index);
+            }
+        };
+
+        typedef std::vector<std::pair<std::vector<double>, std::vector<double>>> Tile;
+
+        const double limit;
+        const size_t capacity;
+        const double windowMinX;
+        const double windowMaxX;
+
+        std::list<std::pair<TileKey, std::shared_ptr<const Tile>>> recentlyUsed;
+        std::map<TileKey, std::list<std::pair<TileKey, std::shared_ptr<const Tile>>>::iterator> index;
+
+        unsigned long long tilesEvaluated;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param limit The absolute value of y after which the point shall not be included in the resulting data.
+         * \param capacity The maximum number of tiles held, which must be positive.
+         * \param windowMinX The minimal x any graph is evaluated for.
+         * \param windowMaxX The maximal x any graph is evaluated for.
+         */
+        GraphTileCache(double limit = 1000.0,
+                       size_t capacity = DefaultCapacity,
+                       double windowMinX = -std::numeric_limits<double>::max(),
+                       double windowMaxX = std::numeric_limits<double>::max());
+        ~GraphTileCache() = default;
+        GraphTileCache(const GraphTileCache&) = delete;
+        GraphTileCache(GraphTileCache&&) = delete;
+        GraphTileCache& operator=(const GraphTileCache&) = delete;
+        GraphTileCache& operator=(GraphTileCache&&) = delete;
+
+        /*!
+         * \brief LevelForViewport determines the level of detail appropriate for the viewport.
+         * \param minX The minimal x of the viewport.
+         * \param maxX The maximal x of the viewport.
+         * \return The level, between 0 and \ref MaxLevel.
+         */
+        static unsigned int LevelForViewport(double minX, double maxX);
+
+        /*!
+         * \brief GetGraph provides the graph of the expression covering the viewport,
+         *        evaluating only the tiles not already cached.
+         * \param expression The expression to evaluate.
+         * \param minX The minimal x of the viewport.
+         * \param maxX The maximal x of the viewport.
+         * \return The graph data covering at least the part of the viewport inside the window, in branches.
+         */
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> GetGraph(const std::shared_ptr<Expression> expression, double minX, double maxX);
+
+        /*!
+         * \brief GetGraph provides the graph of the expression covering the viewport
+         *        at the given level of detail, evaluating only the tiles not already cached.
+         * \param expression The expression to evaluate.
+         * \param minX The minimal x of the viewport.
+         * \param maxX The maximal x of the viewport.
+         * \param level The level of detail, capped at \ref MaxLevel.
+         * \return The graph data covering at least the part of the viewport inside the window, in branches.
+         *
+         * Throws if that part needs more tiles than the capacity.
+         */
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> GetGraph(const std::shared_ptr<Expression> expression, double minX, double maxX, unsigned int level);
+
+        /*!
+         * \brief Gets the number of tiles currently held.
+         * \return The number of tiles.
+         */
+        size_t GetTileCount() const;
+
+        /*!
+         * \brief Gets the number of tiles evaluated since construction, i.e. the number of cache misses.
+         * \return The number of tiles evaluated.
+         */
+        unsigned long long GetTilesEvaluated() const;
+
+        /*!
+         * \brief Clear removes all tiles.
+         */
+        void Clear();
+
+    private:
+        std::shared_ptr<const Tile> GetTile(const std::shared_ptr<Expression> & expression, const TileKey & key);
+        static double GetTileWidth(unsigned int level);
+        static void AppendTile(std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph, const Tile & tile, double joinSquareDistance);
+    };
+
+}
+
+#endif // GRAPHTILECACHE_H
@@ -0,0 +1,284 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "hitscore.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace Backend
+{
+    namespace
+    {
+        /*
+         * Dots with the same hitting functions are interchangeable, so only the number of dots per group matters.
+         * The functions hitting any dot are renumbered densely.
+         */
+        struct Groups
+        {
+            std::vector<std::vector<size_t>> functions;
+            std::vector<int> counts;
+            size_t functionCount;
+        };
+
+        Groups GroupByMask(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot)
+        {
+            std::vector<size_t> dots;
+            for(size_t dot = 0; dot + wordsPerDot <= hitMasks.size(); dot += wordsPerDot)
+            {
+                if(std::any_of(hitMasks.begin() + static_cast<std::ptrdiff_t>(dot), hitMasks.begin() + static_cast<std::ptrdiff_t>(dot + wordsPerDot), [](std::uint64_t word){ return word != 0; }))
+                {
+                    dots.push_back(dot);
+                }
+            }
+
+            std::sort(dots.begin(), dots.end(), [&](size_t left, size_t right)
+            {
+                return std::lexicographical_compare(hitMasks.begin() + static_cast<std::ptrdiff_t>(left), hitMasks.begin() + static_cast<std::ptrdiff_t>(left + wordsPerDot),
+                                                    hitMasks.begin() + static_cast<std::ptrdiff_t>(right), hitMasks.begin() + static_cast<std::ptrdiff_t>(right + wordsPerDot));
+            });
+
+            // dense indices keep the order of the functions
+            std::vector<size_t> denseIndex(wordsPerDot * 64, SIZE_MAX);
+            size_t functionCount(0);
+            for(size_t word = 0; word < wordsPerDot; ++word)
+            {
+                std::uint64_t any(0);
+                for(auto dot : dots)
+                {
+                    any |= hitMasks[dot + word];
+                }
+
+                for(size_t bit = 0; bit < 64; ++bit)
+                {
+                    if((any >> bit & 1u) != 0)
+                    {
+                        denseIndex[word * 64 + bit] = functionCount++;
+                    }
+                }
+            }
+
+            Groups groups;
+            for(size_t i = 0; i < dots.size(); ++i)
+            {
+                if(i > 0 && std::equal(hitMasks.begin() + static_cast<std::ptrdiff_t>(dots[i]), hitMasks.begin() + static_cast<std::ptrdiff_t>(dots[i] + wordsPerDot),
+                                       hitMasks.begin() + static_cast<std::ptrdiff_t>(dots[i - 1])))
+                {
+                    ++groups.counts.back();
+                    continue;
+                }
+
+                std::vector<size_t> functions;
+                for(size_t word = 0; word < wordsPerDot; ++word)
+                {
+                    for(auto bits = hitMasks[dots[i] + word]; bits != 0; bits &= bits - 1)
+                    {
+                        size_t bit(0);
+                        while((bits >> bit & 1u) == 0)
+                        {
+                            ++bit;
+                        }
+
+                        functions.push_back(denseIndex[word * 64 + bit]);
+                    }
+                }
+
+                groups.functions.push_back(functions);
+                groups.counts.push_back(1);
+            }
+
+            groups.functionCount = functionCount;
+            return groups;
+        }
+
+        // scores saturate, as a function hitting 31 dots already scores more than an int holds
+        int ScoreGroup(int count)
+        {
+            if(count >= std::numeric_limits<int>::digits)
+            {
+                return std::numeric_limits<int>::max();
+            }
+
+            return static_cast<int>((std::int64_t(1) << count) - 1);
+        }
+
+        int AddScores(int left, int right)
+        {
+            return static_cast<int>(std::min<std::int64_t>(std::int64_t(left) + right, std::numeric_limits<int>::max()));
+        }
+
+        int ScoreExactly(const Groups & groups)
+        {
+            // without shared dots every function simply takes its own
+            if(std::all_of(groups.functions.begin(), groups.functions.end(), [](const std::vector<size_t> & functions){ return functions.size() == 1; }))
+            {
+                int score(0);
+                for(auto count : groups.counts)
+                {
+                    score = AddScores(score, ScoreGroup(count));
+                }
+
+                return score;
+            }
+
+            std::vector<std::uint32_t> masks;
+            for(auto & functions : groups.functions)
+            {
+                std::uint32_t mask(0);
+                for(auto function : functions)
+                {
+                    mask |= 1u << function;
+                }
+
+                masks.push_back(mask);
+            }
+
+            auto countTaken = [&](size_t function, std::uint32_t scored)
+            {
+                int count(0);
+                for(size_t group = 0; group < masks.size(); ++group)
+                {
+                    if((masks[group] >> function & 1u) != 0 && (masks[group] & scored) == 0)
+                    {
+                        count += groups.counts[group];
+                    }
+                }
+
+                return count;
+            };
+
+            // best[scored] is the best score of the functions in scored, which took every dot any of them hits
+            std::vector<int> best(static_cast<size_t>(1) << groups.functionCount, -1);
+            best[0] = 0;
+            int score(0);
+
+            for(std::uint32_t scored = 0; scored < best.size(); ++scored)
+            {
+                if(best[scored] < 0)
+                {
+                    continue;
+                }
+
+                score = std::max(score, best[scored]);
+
+                for(size_t function = 0; function < groups.functionCount; ++function)
+                {
+                    if((scored >> function & 1u) != 0)
+                    {
+                        continue;
+                    }
+
+                    auto next = scored | (1u << function);
+                    best[next] = std::max(best[next], AddScores(best[scored], ScoreGroup(countTaken(function, scored))));
+                }
+            }
+
+            return score;
+        }
+
+        int ScoreGreedily(const Groups & groups)
+        {
+            std::vector<int> counts(groups.functionCount, 0);
+            std::vector<std::vector<size_t>> groupsOfFunction(groups.functionCount);
+
+            for(size_t group = 0; group < groups.functions.size(); ++group)
+            {
+                for(auto function : groups.functions[group])
+                {
+                    counts[function] += groups.counts[group];
+                    groupsOfFunction[function].push_back(group);
+                }
+            }
+
+            // counts only drop, so an outdated entry is just put back with its current count when it comes up
+            auto isLower = [](const std::pair<int, size_t> & left, const std::pair<int, size_t> & right)
+            {
+                return left.first < right.first || (left.first == right.first && left.second > right.second);
+            };
+
+            std::priority_queue<std::pair<int, size_t>, std::vector<std::pair<int, size_t>>, decltype(isLower)> queue(isLower);
+            for(size_t function = 0; function < groups.functionCount; ++function)
+            {
+                queue.emplace(counts[function], function);
+            }
+
+            std::vector<bool> isTaken(groups.functions.size(), false);
+            int score(0);
+
+            while(!queue.empty())
+            {
+                auto top = queue.top();
+                queue.pop();
+
+                if(top.first == 0)
+                {
+                    break;
+                }
+
+                if(top.first != counts[top.second])
+                {
+                    queue.emplace(counts[top.second], top.second);
+                    continue;
+                }
+
+                score = AddScores(score, ScoreGroup(top.first));
+
+                for(auto group : groupsOfFunction[top.second])
+                {
+                    if(isTaken[group])
+                    {
+                        continue;
+                    }
+
+                    isTaken[group] = true;
+                    for(auto function : groups.functions[group])
+                    {
+                        counts[function] -= groups.counts[group];
+                    }
+                }
+            }
+
+            return score;
+        }
+    }
+
+    int GetOptimalHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot)
+    {
+        auto groups = GroupByMask(hitMasks, wordsPerDot);
+
+        if(groups.functionCount > 24)
+        {
+            throw std::exception("too many functions hitting dots to score exactly");
+        }
+
+        return ScoreExactly(groups);
+    }
+
+    int GetGreedyHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot)
+    {
+        return ScoreGreedily(GroupByMask(hitMasks, wordsPerDot));
+    }
+
+    int GetHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot)
+    {
+        auto groups = GroupByMask(hitMasks, wordsPerDot);
+        return groups.functionCount <= MaxExactHitScoreFunctions ? ScoreExactly(groups) : ScoreGreedily(groups);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef HITSCORE_H
+#define HITSCORE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Backend
+{
+    /*!
+     * \brief MaxExactHitScoreFunctions is the largest number of functions hitting dots that \ref GetHitScore scores exactly.
+     */
+    constexpr const size_t MaxExactHitScoreFunctions = 12;
+
+    /*!
+     * \brief GetOptimalHitScore calculates the best score reachable by assigning each hit dot to one of the functions hitting it,
+     *        each function scoring 2^k-1 for its k dots.
+     *
+     * Scores beyond the range of int saturate at its maximum.
+     *
+     * A function taking the most dots takes all the dots it hits in an optimal assignment, so the functions only need to be ordered.
+     * The best order is found exactly over the subsets of functions already scored, which is exponential in the functions hitting dots.
+     * \param hitMasks The functions hitting each dot, one bit per function in \a wordsPerDot consecutive words per dot.
+     * \param wordsPerDot The number of words per dot.
+     * \return The optimal score.
+     */
+    int GetOptimalHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot = 1);
+
+    /*!
+     * \brief GetGreedyHitScore calculates the score reached by repeatedly letting the function hitting most of the remaining dots take them.
+     * \param hitMasks The functions hitting each dot, one bit per function in \a wordsPerDot consecutive words per dot.
+     * \param wordsPerDot The number of words per dot.
+     * \return The greedy score, never greater than the optimal one.
+     */
+    int GetGreedyHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot = 1);
+
+    /*!
+     * \brief GetHitScore calculates the optimal score if at most \ref MaxExactHitScoreFunctions functions hit dots and the greedy score otherwise.
+     * \param hitMasks The functions hitting each dot, one bit per function in \a wordsPerDot consecutive words per dot.
+     * \param wordsPerDot The number of words per dot.
+     * \return The score.
+     */
+    int GetHitScore(const std::vector<std::uint64_t> & hitMasks, size_t wordsPerDot = 1);
+}
+
+#endif // HITSCORE_H
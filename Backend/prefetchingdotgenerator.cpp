@@ -0,0 +1,137 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "prefetchingdotgenerator.h"
+
+namespace Backend
+{
+    PrefetchingDotGenerator::PrefetchingDotGenerator(std::shared_ptr<DotGenerator> generator, size_t depth)
+        : generator(generator),
+          depth(depth),
+          isStopping(false)
+    {
+        if(!this->generator)
+        {
+            throw std::exception("prefetching needs a dot generator");
+        }
+    }
+
+    PrefetchingDotGenerator::~PrefetchingDotGenerator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->isStopping = true;
+        }
+
+        this->boardTaken.notify_all();
+
+        if(this->worker.joinable())
+        {
+            this->worker.join();
+        }
+    }
+
+    std::vector<std::shared_ptr<Dot>> PrefetchingDotGenerator::Generate()
+    {
+        if(this->depth == 0)
+        {
+            return this->generator->Generate();
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        // until the first board is asked for, the other generator may still be used elsewhere
+        if(!this->worker.joinable())
+        {
+            this->worker = std::thread(&PrefetchingDotGenerator::Work, this);
+        }
+
+        this->boardReady.wait(lock, [this]{ return !this->boards.empty() || this->generationException; });
+
+        // boards generated before the failure are handed out first
+        if(this->boards.empty())
+        {
+            auto exception = this->generationException;
+            this->generationException = nullptr;
+            lock.unlock();
+            this->boardTaken.notify_one();
+            std::rethrow_exception(exception);
+        }
+
+        auto board = std::move(this->boards.front());
+        this->boards.pop_front();
+        lock.unlock();
+        this->boardTaken.notify_one();
+
+        return board;
+    }
+
+    size_t PrefetchingDotGenerator::GetDepth() const
+    {
+        return this->depth;
+    }
+
+    size_t PrefetchingDotGenerator::GetReadyCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->boards.size();
+    }
+
+    void PrefetchingDotGenerator::Work()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while(true)
+        {
+            // a failure is reported before trying again
+            this->boardTaken.wait(lock, [this]{ return this->isStopping || (this->boards.size() < this->depth && !this->generationException); });
+
+            if(this->isStopping)
+            {
+                return;
+            }
+
+            lock.unlock();
+
+            std::vector<std::shared_ptr<Dot>> board;
+            std::exception_ptr exception;
+
+            try
+            {
+                board = this->generator->Generate();
+            }
+            catch(...)
+            {
+                exception = std::current_exception();
+            }
+
+            lock.lock();
+
+            if(exception)
+            {
+                this->generationException = exception;
+            }
+            else
+            {
+                this->boards.push_back(std::move(board));
+            }
+
+            this->boardReady.notify_all();
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PREFETCHINGDOTGENERATOR_H
+#define PREFETCHINGDOTGENERATOR_H
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "dotgenerator.h"
+
+namespace Backend
+{
+    /*!
+     * \class PrefetchingDotGenerator
+     * \brief The PrefetchingDotGenerator class generates the next boards of another generator on a background thread,
+     *        so that starting a new game does not wait for the generation.
+     *
+     * Generating starts with the first call of Generate(), from then on the other generator is used by the background thread only.
+     */
+    class PrefetchingDotGenerator final : public DotGenerator
+    {
+    private:
+        std::shared_ptr<DotGenerator> generator;
+        const size_t depth;
+
+        std::mutex mutex;
+        std::condition_variable boardTaken;
+        std::condition_variable boardReady;
+        std::deque<std::vector<std::shared_ptr<Dot>>> boards;
+        std::exception_ptr generationException;
+        bool isStopping;
+        std::thread worker;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param generator The generator to create the boards.
+         * \param depth The number of boards to keep ready, 0 meaning to generate on demand.
+         */
+        explicit PrefetchingDotGenerator(std::shared_ptr<DotGenerator> generator, size_t depth = 1);
+        ~PrefetchingDotGenerator();
+        PrefetchingDotGenerator(const PrefetchingDotGenerator&) = delete;
+        PrefetchingDotGenerator(PrefetchingDotGenerator&&) = delete;
+        PrefetchingDotGenerator& operator=(const PrefetchingDotGenerator&) = delete;
+        PrefetchingDotGenerator& operator=(PrefetchingDotGenerator&&) = delete;
+
+        /*!
+         * \reimp
+         *
+         * Hands out the oldest board kept ready, waiting for it if necessary.
+         * An exception thrown by the other generator is rethrown here.
+         */
+        virtual std::vector<std::shared_ptr<Dot>> Generate();
+
+        /*!
+         * \brief GetDepth gets the number of boards kept ready.
+         * \return The depth.
+         */
+        size_t GetDepth() const;
+
+        /*!
+         * \brief GetReadyCount gets the number of boards currently ready.
+         * \return The number of boards that can be handed out without waiting.
+         */
+        size_t GetReadyCount();
+
+    private:
+        void Work();
+    };
+}
+
+#endif // PREFETCHINGDOTGENERATOR_H
@@ -0,0 +1,119 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "progressiveevaluator.h"
+#include "evaluator.h"
+#include "discontinuitylocator.h"
+
+namespace Backend {
+
+    const std::vector<unsigned int> ProgressiveEvaluator::PassSampleCounts = { 64, 256, 1024 };
+
+    ProgressiveEvaluator::ProgressiveEvaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit, std::shared_ptr<CancellationToken> cancellationToken)
+        : expression(expression),
+          minX(minX),
+          maxX(maxX),
+          limit(limit),
+          cancellationToken(cancellationToken)
+    {
+    }
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> ProgressiveEvaluator::Evaluate(std::function<void(std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> publish)
+    {
+        for(auto sampleCount : ProgressiveEvaluator::PassSampleCounts)
+        {
+            if(this->IsCancelled())
+            {
+                break;
+            }
+
+            publish(std::make_shared<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>(this->EvaluateUniformly(sampleCount)));
+        }
+
+        Evaluator evaluator(this->expression, this->minX, this->maxX, this->limit, 1.0, this->cancellationToken);
+        auto graph = evaluator.Evaluate();
+
+        if(!this->IsCancelled())
+        {
+            publish(std::make_shared<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>(graph));
+        }
+
+        return graph;
+    }
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> ProgressiveEvaluator::EvaluateUniformly(unsigned int sampleCount) const
+    {
+        if(sampleCount < 2)
+        {
+            throw std::exception("programmer mistake: uniform evaluation requires at least two samples");
+        }
+
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData;
+        graphData.emplace_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+
+        auto startNewBranch = [&]()
+        {
+            if(!graphData.back().first.empty())
+            {
+                graphData.emplace_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+            }
+        };
+
+        DiscontinuityLocator locator(this->expression, this->limit, 0.0);
+
+        double step = (this->maxX - this->minX) / static_cast<double>(sampleCount - 1);
+
+        for(unsigned int i = 0; i < sampleCount; ++i)
+        {
+            double x = this->minX + step * static_cast<double>(i);
+            auto yOptional = this->expression->Evaluate(x);
+
+            if(!yOptional.has_value() || std::abs(yOptional.value()) > this->limit)
+            {
+                startNewBranch();
+                continue;
+            }
+
+            double y = yOptional.value();
+            auto & branch = graphData.back();
+
+            if(!branch.first.empty() && locator.IsPoleBetween(branch.first.back(), branch.second.back(), x, y))
+            {
+                startNewBranch();
+            }
+
+            graphData.back().first.emplace_back(x);
+            graphData.back().second.emplace_back(y);
+        }
+
+        if(graphData.size() > 1 && graphData.back().first.empty())
+        {
+            graphData.pop_back();
+        }
+
+        return graphData;
+    }
+
+    bool ProgressiveEvaluator::IsCancelled() const
+    {
+        return this->cancellationToken && this->cancellationToken->IsCancelled();
+    }
+
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PROGRESSIVEEVALUATOR_H
+#define PROGRESSIVEEVALUATOR_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "expression.h"
+#include "cancellationtoken.h"
+
+namespace Backend {
+
+    /*!
+     * \class ProgressiveEvaluator
+     * \brief The ProgressiveEvaluator class creates the graph of an expression in passes from coarse to fine.
+     *
+     * The first passes sample the expression on uniform grids of increasing density, the last pass
+     * is the adaptive evaluation of \ref Evaluator. Every pass is published as an immutable snapshot,
+     * such that a consumer can display a graph long before the final pass is complete.
+     */
+    class ProgressiveEvaluator final
+    {
+    public:
+        /*!
+         * \brief PassSampleCounts are the numbers of samples of the uniform passes preceding the adaptive pass.
+         */
+        static const std::vector<unsigned int> PassSampleCounts;
+
+    private:
+        std::shared_ptr<Expression> expression;
+        const double minX;
+        const double maxX;
+        const double limit;
+        const std::shared_ptr<CancellationToken> cancellationToken;
+
+    public:
+        /*!
+         * \brief Initializes a new instance for the given expression and parameters.
+         * \param expression The expression to evaluate.
+         * \param minX The minimal x to consider.
+         * \param maxX The maximal x to consider.
+         * \param limit The absolute value of y after which the point shall not be included in the resulting data.
+         * \param cancellationToken The optional token to stop the evaluation early, skipping the remaining passes.
+         */
+        ProgressiveEvaluator(std::shared_ptr<Expression> expression, double minX, double maxX, double limit, std::shared_ptr<CancellationToken> cancellationToken = nullptr);
+        ~ProgressiveEvaluator() = default;
+        ProgressiveEvaluator(const ProgressiveEvaluator&) = delete;
+        ProgressiveEvaluator& operator=(const ProgressiveEvaluator&) = delete;
+        ProgressiveEvaluator(ProgressiveEvaluator&&) = delete;
+        ProgressiveEvaluator& operator=(ProgressiveEvaluator&&) = delete;
+
+        /*!
+         * \brief Evaluate creates the graph data in passes, publishing each pass.
+         * \param publish The function accepting the snapshot of each pass, called on the evaluating thread.
+         * \return The graph data of the final, adaptive pass.
+         */
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> Evaluate(std::function<void(std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> publish);
+
+        /*!
+         * \brief EvaluateUniformly creates graph data from samples at equal distances.
+         * \param sampleCount The number of samples, at least two.
+         * \return The graph data, split into branches where the expression is undefined, beyond the limit or has a pole.
+         */
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> EvaluateUniformly(unsigned int sampleCount) const;
+
+    private:
+        bool IsCancelled() const;
+    };
+
+}
+
+#endif // PROGRESSIVEEVALUATOR_H
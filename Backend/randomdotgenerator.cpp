@@ -16,56 +16,77 @@
  *
  */
 
-#include <random>
+#include <utility>
 #include "randomdotgenerator.h"
 
 namespace Backend
 {
     RandomDotGenerator::RandomDotGenerator(unsigned short goodDots, unsigned short badDots)
-        : goodDots(goodDots),
-          badDots(badDots)
+        : RandomDotGenerator(BoardSpec(goodDots, badDots), RandomDotGenerator::GetSystemSeed())
     {
     }
 
-    std::vector<std::shared_ptr<Dot>> RandomDotGenerator::Generate()
+    RandomDotGenerator::RandomDotGenerator(const BoardSpec & boardSpec)
+        : RandomDotGenerator(boardSpec, RandomDotGenerator::GetSystemSeed())
+    {
+    }
+
+    RandomDotGenerator::RandomDotGenerator(const BoardSpec & boardSpec, std::uint64_t seed)
+        : boardSpec(boardSpec),
+          engine(seed)
     {
-        const int maxLine = 19;
-        const int maxPositions = maxLine*maxLine;
-        const double downCorrection = 9.0;
+    }
 
-        if(goodDots + badDots > maxPositions)
+    std::vector<std::shared_ptr<Dot>> RandomDotGenerator::Generate()
+    {
+        const unsigned int maxLine = boardSpec.GetLatticeLines();
+        const size_t maxPositions = static_cast<size_t>(maxLine) * maxLine;
+        const double origin = boardSpec.GetLatticeOrigin();
+        const double spacing = boardSpec.GetLatticeSpacing();
+        const double maxOffset = boardSpec.GetMaxOffset();
+        const size_t dotCount = static_cast<size_t>(boardSpec.GetGoodDots()) + boardSpec.GetBadDots();
+
+        if(dotCount > maxPositions)
         {
             throw std::exception("programmer mistake: cannot use more than maxPositions dots");
         }
 
-        std::vector<int> allPositions;
-        for (int i = 0; i<maxPositions; ++i)
+        // any order of the positions is a valid start for the next shuffle
+        if(this->positions.size() != maxPositions)
         {
-            allPositions.push_back(i);
+            this->positions.resize(maxPositions);
+            for (size_t i = 0; i<maxPositions; ++i)
+            {
+                this->positions[i] = i;
+            }
         }
 
         std::vector<std::shared_ptr<Dot>> retval;
+        retval.reserve(dotCount);
 
+        // partial Fisher-Yates shuffle, the first positions are the ones picked
         auto createDot = [&](const bool kind)
         {
-            auto index = RandomDotGenerator::GetRandomIndexUpToIncluding(allPositions.size() - 1);
-            int position = allPositions[index];
-            allPositions.erase(allPositions.begin() + index);
+            auto picked = retval.size();
+            auto index = picked + this->GetRandomIndexBelow(maxPositions - picked);
+            std::swap(this->positions[picked], this->positions[index]);
+            size_t position = this->positions[picked];
 
-            auto x = static_cast<double>(position/maxLine) - downCorrection + RandomDotGenerator::GetRandomOffset();
-            auto y = static_cast<double>(position%maxLine) - downCorrection + RandomDotGenerator::GetRandomOffset();
+            auto x = origin + spacing * static_cast<double>(position/maxLine) + this->GetRandomOffset(maxOffset);
+            auto y = origin + spacing * static_cast<double>(position%maxLine) + this->GetRandomOffset(maxOffset);
+            auto radius = this->GetRandomRadius(boardSpec.GetMinRadius(), boardSpec.GetMaxRadius());
 
-            retval.push_back(std::make_shared<Dot>(x, y, kind));
+            retval.push_back(std::make_shared<Dot>(x, y, kind, radius));
         };
 
-        for (int i = 0; i<goodDots; ++i)
+        for (unsigned int i = 0; i<boardSpec.GetGoodDots(); ++i)
         {
             const bool goodDot = true;
 
             createDot(goodDot);
         }
 
-        for (int i = 0; i<badDots; ++i)
+        for (unsigned int i = 0; i<boardSpec.GetBadDots(); ++i)
         {
             const bool goodDot = false;
 
@@ -75,21 +96,49 @@ namespace Backend
         return retval;
     }
 
-    /* static class member */ size_t RandomDotGenerator::GetRandomIndexUpToIncluding(size_t upper)
+    /* static class member */ std::uint64_t RandomDotGenerator::GetSystemSeed()
+    {
+        std::random_device rd;
+        std::uint64_t seed = rd();
+        seed = (seed << 32) | rd();
+        return seed;
+    }
+
+    size_t RandomDotGenerator::GetRandomIndexBelow(size_t bound)
+    {
+        // the standard distributions differ between platforms, rejecting the incomplete range at the bottom keeps the index uniform
+        const std::uint64_t range = bound;
+        const std::uint64_t threshold = (0 - range) % range;
+
+        std::uint64_t value;
+        do
+        {
+            value = this->engine();
+        }
+        while(value < threshold);
+
+        return static_cast<size_t>(value % range);
+    }
+
+    double RandomDotGenerator::GetRandomUnit()
     {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<size_t> dis(0, upper);
-        return dis(gen);
+        // 53 bits fill the mantissa, giving a value in [0, 1)
+        return static_cast<double>(this->engine() >> 11) * (1.0 / 9007199254740992.0);
     }
 
-    /* static class member */ double RandomDotGenerator::GetRandomOffset()
+    double RandomDotGenerator::GetRandomOffset(double maxOffset)
     {
-        const double maxOffset = 0.15;
+        return -maxOffset + 2.0 * maxOffset * this->GetRandomUnit();
+    }
+
+    double RandomDotGenerator::GetRandomRadius(double minRadius, double maxRadius)
+    {
+        // a fixed radius leaves the sequence of random numbers as it was
+        if(minRadius == maxRadius)
+        {
+            return minRadius;
+        }
 
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution  dis(-maxOffset, maxOffset);
-        return dis(gen);
+        return minRadius + (maxRadius - minRadius) * this->GetRandomUnit();
     }
 }
@@ -19,35 +19,65 @@
 #ifndef RANDOMDOTGENERATOR_H
 #define RANDOMDOTGENERATOR_H
 
+#include <cstdint>
+#include <random>
+#include <vector>
 #include "dotgenerator.h"
+#include "boardspec.h"
 
 namespace Backend
 {
     /*!
      * \class RandomDotgenerator
-     * \brief The RandomDotgenerator class creates dots a grid points using a offset. It can generate 361 dots total.
+     * \brief The RandomDotgenerator class creates dots a grid points using a offset.
+     *        The classic board can hold 361 dots total, larger boards are described by a \ref BoardSpec.
+     *
+     * Each instance draws from its own engine, so a seeded instance creates the same sequence of boards on every platform.
+     * An instance must not be used by several threads at once.
      */
     class RandomDotGenerator final : public DotGenerator
     {
     private:
-        unsigned short goodDots;
-        unsigned short badDots;
+        BoardSpec boardSpec;
+        std::mt19937_64 engine;
+
+        /*!
+         * \brief positions holds every lattice position once, the ones picked for a board are swapped to the front.
+         */
+        std::vector<size_t> positions;
+
     public:
         /*!
-         * \brief Initializes a new instance.
+         * \brief Initializes a new instance seeded from the system.
          * \param goodDots The number of good dots to create.
          * \param badDots The number of bad dots to create.
          */
         RandomDotGenerator(unsigned short goodDots, unsigned short badDots);
 
+        /*!
+         * \brief Initializes a new instance seeded from the system.
+         * \param boardSpec The board to create the dots for.
+         */
+        explicit RandomDotGenerator(const BoardSpec & boardSpec);
+
+        /*!
+         * \brief Initializes a new instance creating a reproducible sequence of boards.
+         * \param boardSpec The board to create the dots for.
+         * \param seed The seed of the engine.
+         */
+        RandomDotGenerator(const BoardSpec & boardSpec, std::uint64_t seed);
+
         /*!
          * \reimp
          */
         virtual std::vector<std::shared_ptr<Dot>> Generate();
 
     private:
-        static size_t GetRandomIndexUpToIncluding(size_t upper);
-        static double GetRandomOffset();
+        static std::uint64_t GetSystemSeed();
+        size_t GetRandomIndexBelow(size_t bound);
+        double GetRandomUnit();
+        double GetRandomOffset(double maxOffset);
+        double GetRandomRadius(double minRadius, double maxRadius);
     };
 }
 
@@ -0,0 +1,580 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sessionmanager.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Backend {
+
+    namespace
+    {
+        typedef rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> Document;
+        typedef rapidjson::GenericStringBuffer<rapidjson::UTF16<wchar_t>> Buffer;
+        typedef rapidjson::Writer<Buffer, rapidjson::UTF16<wchar_t>, rapidjson::UTF16<wchar_t>> Writer;
+
+        const wchar_t * const KeyId = L"id";
+        const wchar_t * const KeyCommand = L"command";
+        const wchar_t * const KeySession = L"session";
+        const wchar_t * const KeyFunctions = L"functions";
+        const wchar_t * const KeyFile = L"file";
+
+        const wchar_t * const CommandCreate = L"create";
+        const wchar_t * const CommandUpdate = L"update";
+        const wchar_t * const CommandScore = L"score";
+        const wchar_t * const CommandSave = L"save";
+        const wchar_t * const CommandLoad = L"load";
+        const wchar_t * const CommandRemake = L"remake";
+        const wchar_t * const CommandClose = L"close";
+        const wchar_t * const CommandStats = L"stats";
+
+        void WriteString(Writer & writer, const std::wstring & value)
+        {
+            writer.String(value.c_str(), static_cast<rapidjson::SizeType>(value.size()));
+        }
+
+        void StartResponse(Writer & writer, const Document & document, bool isOk)
+        {
+            writer.StartObject();
+
+            if(document.IsObject() && document.HasMember(KeyId))
+            {
+                writer.Key(KeyId);
+                document[KeyId].Accept(writer);
+            }
+
+            writer.Key(L"ok");
+            writer.Bool(isOk);
+        }
+
+        std::wstring MakeError(const Document & document, const std::wstring & error)
+        {
+            Buffer buffer;
+            Writer writer(buffer);
+
+            StartResponse(writer, document, false);
+            writer.Key(L"error");
+            WriteString(writer, error);
+            writer.EndObject();
+
+            return std::wstring(buffer.GetString());
+        }
+
+        void WriteState(Writer & writer, const Game & game)
+        {
+            writer.Key(L"score");
+            writer.Int(game.GetScore());
+
+            writer.Key(L"dots");
+            writer.StartArray();
+            for(const auto & dot : game.GetDots())
+            {
+                auto coordinates = dot->GetCoordinates();
+
+                writer.StartObject();
+                writer.Key(L"x");
+                writer.Double(coordinates.first);
+                writer.Key(L"y");
+                writer.Double(coordinates.second);
+                writer.Key(L"radius");
+                writer.Double(dot->GetRadius());
+                writer.Key(L"good");
+                writer.Bool(dot->IsGood());
+                writer.Key(L"hit");
+                writer.Bool(dot->IsActive());
+                writer.EndObject();
+            }
+            writer.EndArray();
+        }
+
+        std::wstring GetString(const Document & document, const wchar_t * key)
+        {
+            const auto & value = document[key];
+            return std::wstring(value.GetString(), value.GetStringLength());
+        }
+
+        bool HasString(const Document & document, const wchar_t * key)
+        {
+            return document.HasMember(key) && document[key].IsString();
+        }
+
+        bool IsPlainFileName(const std::wstring & file)
+        {
+            // clients name files only inside the save directory, so neither separators, drives nor "." and ".." are allowed
+            return !file.empty() && file.front() != L'.'
+                    && std::all_of(file.begin(), file.end(), [](wchar_t character)
+            {
+                return (character >= L'a' && character <= L'z') || (character >= L'A' && character <= L'Z')
+                        || (character >= L'0' && character <= L'9') || character == L'.' || character == L'-' || character == L'_';
+            });
+        }
+
+        std::vector<std::wstring> GetFunctions(const Document & document, unsigned long int functionLimit)
+        {
+            std::vector<std::wstring> functions;
+            const auto & values = document[KeyFunctions];
+            for(auto function = values.Begin(); function != values.End() && functions.size() < functionLimit; ++function)
+            {
+                functions.push_back(std::wstring(function->GetString(), function->GetStringLength()));
+            }
+
+            // unmentioned slots are emptied rather than left as they were
+            functions.resize(functionLimit);
+
+            return functions;
+        }
+
+        bool TryValidate(const Document & document, std::wstring & command, std::wstring & session, std::wstring & error)
+        {
+            if(!document.IsObject())
+            {
+                error = L"request is not an object";
+                return false;
+            }
+
+            if(!HasString(document, KeyCommand))
+            {
+                error = L"request has no command";
+                return false;
+            }
+
+            command = GetString(document, KeyCommand);
+
+            if(command == CommandStats)
+            {
+                return true;
+            }
+
+            if(command != CommandCreate && command != CommandUpdate && command != CommandScore && command != CommandSave
+                    && command != CommandLoad && command != CommandRemake && command != CommandClose)
+            {
+                error = std::wstring(L"unknown command: ") + command;
+                return false;
+            }
+
+            if(!HasString(document, KeySession))
+            {
+                error = L"request has no session";
+                return false;
+            }
+
+            session = GetString(document, KeySession);
+
+            bool hasFunctions = document.HasMember(KeyFunctions);
+            if(hasFunctions)
+            {
+                const auto & functions = document[KeyFunctions];
+                if(!(functions.IsArray() && std::all_of(functions.Begin(), functions.End(), [](const auto & function) { return function.IsString(); })))
+                {
+                    error = L"functions are not an array of strings";
+                    return false;
+                }
+            }
+
+            if(command == CommandUpdate && !hasFunctions)
+            {
+                error = L"update needs functions";
+                return false;
+            }
+
+            if((command == CommandSave || command == CommandLoad) && !HasString(document, KeyFile))
+            {
+                error = command + L" needs a file";
+                return false;
+            }
+
+            if((command == CommandSave || command == CommandLoad) && !IsPlainFileName(GetString(document, KeyFile)))
+            {
+                error = L"file must be a plain name of letters, digits, '.', '-' and '_'";
+                return false;
+            }
+
+            return true;
+        }
+    }
+
+    SessionManager::SessionManager(std::shared_ptr<DotGenerator> dotGenerator, std::shared_ptr<Repository> repository, unsigned int workerCount, unsigned long int functionLimit)
+        : dotGenerator(dotGenerator),
+          repository(repository),
+          functionLimit(functionLimit),
+          outstandingCount(0),
+          isStopping(false),
+          completedCount(0)
+    {
+        if(functionLimit == 0)
+        {
+            throw std::exception("a game needs to allow functions");
+        }
+
+        if(workerCount == 0)
+        {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        this->latencies.reserve(SessionManager::LatencySampleCount);
+
+        for(unsigned int i = 0; i < workerCount; ++i)
+        {
+            this->workers.emplace_back(&SessionManager::Work, this);
+        }
+    }
+
+    SessionManager::~SessionManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->isStopping = true;
+        }
+
+        this->wakeUp.notify_all();
+
+        for(auto & worker : this->workers)
+        {
+            worker.join();
+        }
+    }
+
+    void SessionManager::Submit(const std::wstring & requestLine, std::function<void(const std::wstring&)> respond)
+    {
+        Request request { std::make_shared<Document>(), respond, std::chrono::steady_clock::now() };
+        auto & document = *request.document;
+        document.Parse(requestLine.c_str());
+
+        if(document.HasParseError())
+        {
+            respond(MakeError(document, L"request is not valid JSON"));
+            return;
+        }
+
+        std::wstring command;
+        std::wstring sessionId;
+        std::wstring error;
+        if(!TryValidate(document, command, sessionId, error))
+        {
+            respond(MakeError(document, error));
+            return;
+        }
+
+        if(command == CommandStats)
+        {
+            respond(this->GetStats(document));
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            auto sessionIt = this->sessions.find(sessionId);
+            std::shared_ptr<Session> session;
+
+            if(command == CommandCreate)
+            {
+                if(sessionIt != this->sessions.end())
+                {
+                    error = std::wstring(L"session already exists: ") + sessionId;
+                }
+                else
+                {
+                    session = std::make_shared<Session>();
+                    session->isScheduled = false;
+                    this->sessions[sessionId] = session;
+                }
+            }
+            else if(sessionIt == this->sessions.end())
+            {
+                error = std::wstring(L"unknown session: ") + sessionId;
+            }
+            else
+            {
+                session = sessionIt->second;
+
+                // the session is gone for further requests, but executes the ones before closing
+                if(command == CommandClose)
+                {
+                    this->sessions.erase(sessionIt);
+                }
+            }
+
+            if(session)
+            {
+                session->requests.push_back(request);
+                ++this->outstandingCount;
+
+                if(!session->isScheduled)
+                {
+                    session->isScheduled = true;
+                    this->readySessions.push_back(session);
+                    this->wakeUp.notify_one();
+                }
+            }
+        }
+
+        if(!error.empty())
+        {
+            respond(MakeError(document, error));
+        }
+    }
+
+    void SessionManager::WaitUntilIdle()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->idle.wait(lock, [this]() { return this->outstandingCount == 0; });
+    }
+
+    size_t SessionManager::GetSessionCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->sessions.size();
+    }
+
+    unsigned int SessionManager::GetWorkerCount() const
+    {
+        return static_cast<unsigned int>(this->workers.size());
+    }
+
+    unsigned long int SessionManager::GetCompletedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->latencyMutex);
+        return this->completedCount;
+    }
+
+    double SessionManager::GetLatencyPercentile(double percentile)
+    {
+        std::vector<double> sorted;
+        {
+            std::lock_guard<std::mutex> lock(this->latencyMutex);
+            sorted = this->latencies;
+        }
+
+        if(sorted.empty())
+        {
+            return 0.0;
+        }
+
+        // nearest rank
+        auto rank = static_cast<size_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * sorted.size()));
+        auto index = rank == 0 ? 0 : rank - 1;
+
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+
+    void SessionManager::Work()
+    {
+        for(;;)
+        {
+            std::shared_ptr<Session> session;
+            Request request;
+
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->wakeUp.wait(lock, [this]() { return this->isStopping || !this->readySessions.empty(); });
+
+                if(this->readySessions.empty())
+                {
+                    return;
+                }
+
+                session = this->readySessions.front();
+                this->readySessions.pop_front();
+                request = session->requests.front();
+                session->requests.pop_front();
+            }
+
+            // only this worker touches the game, as the session is not ready again before it is done
+            std::wstring response;
+            try
+            {
+                response = this->Execute(*session, request);
+            }
+            catch(const std::exception&)
+            {
+                response = MakeError(*request.document, L"exception when executing request");
+            }
+
+            this->Complete(request, response);
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                // one request per turn, so that a busy session does not starve the others
+                if(session->requests.empty())
+                {
+                    session->isScheduled = false;
+                }
+                else
+                {
+                    this->readySessions.push_back(session);
+                    this->wakeUp.notify_one();
+                }
+
+                --this->outstandingCount;
+                if(this->outstandingCount == 0)
+                {
+                    this->idle.notify_all();
+                }
+            }
+        }
+    }
+
+    std::wstring SessionManager::Execute(Session & session, const Request & request)
+    {
+        const auto & document = *request.document;
+        auto command = GetString(document, KeyCommand);
+
+        if(command == CommandCreate)
+        {
+            // the generator is shared by all sessions, so games are created one at a time
+            std::lock_guard<std::mutex> lock(this->dotGeneratorMutex);
+            session.game = std::make_unique<Game>(this->dotGenerator, this->repository, 1, this->functionLimit);
+        }
+        else if(!session.game)
+        {
+            return MakeError(document, L"session has no game");
+        }
+
+        Buffer buffer;
+        Writer writer(buffer);
+        Game & game = *session.game;
+
+        if(command == CommandCreate || command == CommandUpdate)
+        {
+            if(command == CommandUpdate)
+            {
+                game.Update(GetFunctions(document, this->functionLimit));
+            }
+
+            StartResponse(writer, document, true);
+            WriteState(writer, game);
+        }
+        else if(command == CommandScore)
+        {
+            if(document.HasMember(KeyFunctions))
+            {
+                auto report = game.UpdateScoreOnly(GetFunctions(document, this->functionLimit));
+
+                StartResponse(writer, document, true);
+                writer.Key(L"score");
+                writer.Int(report.score);
+                writer.Key(L"functionsEvaluated");
+                writer.Uint64(report.functionsEvaluated);
+                writer.Key(L"windowsEvaluated");
+                writer.Uint64(report.windowsEvaluated);
+            }
+            else
+            {
+                StartResponse(writer, document, true);
+                WriteState(writer, game);
+            }
+        }
+        else if(command == CommandSave)
+        {
+            auto result = game.Save(GetString(document, KeyFile));
+            if(!result.first)
+            {
+                return MakeError(document, result.second);
+            }
+
+            StartResponse(writer, document, true);
+        }
+        else if(command == CommandLoad)
+        {
+            auto result = game.Load(GetString(document, KeyFile));
+            if(!result.first)
+            {
+                return MakeError(document, result.second);
+            }
+
+            StartResponse(writer, document, true);
+            WriteState(writer, game);
+            writer.Key(KeyFunctions);
+            writer.StartArray();
+            for(const auto & function : game.GetFunctions())
+            {
+                WriteString(writer, function);
+            }
+            writer.EndArray();
+        }
+        else if(command == CommandRemake)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->dotGeneratorMutex);
+                game.Remake();
+            }
+
+            StartResponse(writer, document, true);
+            WriteState(writer, game);
+        }
+        else if(command == CommandClose)
+        {
+            session.game.reset();
+            StartResponse(writer, document, true);
+        }
+
+        writer.EndObject();
+
+        return std::wstring(buffer.GetString());
+    }
+
+    void SessionManager::Complete(const Request & request, const std::wstring & response)
+    {
+        auto latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - request.submitted).count();
+
+        {
+            std::lock_guard<std::mutex> lock(this->latencyMutex);
+
+            if(this->latencies.size() < SessionManager::LatencySampleCount)
+            {
+                this->latencies.push_back(latency);
+            }
+            else
+            {
+                this->latencies[this->completedCount % SessionManager::LatencySampleCount] = latency;
+            }
+
+            ++this->completedCount;
+        }
+
+        request.respond(response);
+    }
+
+    std::wstring SessionManager::GetStats(const Document & document)
+    {
+        Buffer buffer;
+        Writer writer(buffer);
+
+        StartResponse(writer, document, true);
+        writer.Key(L"sessions");
+        writer.Uint64(this->GetSessionCount());
+        writer.Key(L"completed");
+        writer.Uint64(this->GetCompletedCount());
+        writer.Key(L"p50");
+        writer.Double(this->GetLatencyPercentile(50.0));
+        writer.Key(L"p90");
+        writer.Double(this->GetLatencyPercentile(90.0));
+        writer.Key(L"p99");
+        writer.Double(this->GetLatencyPercentile(99.0));
+        writer.EndObject();
+
+        return std::wstring(buffer.GetString());
+    }
+
+}
@@ -0,0 +1,171 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "classes.h"
+#include "game.h"
+#include "dotgenerator.h"
+#include "randomdotgenerator.h"
+#include "repository.h"
+#include "diskrepository.h"
+#include "rapidjson/document.h"
+
+namespace Backend {
+
+    /*!
+     * \class SessionManager
+     * \brief The SessionManager class hosts many games by session id and serves requests to them on a fixed set of worker threads.
+     *
+     * Requests and responses are single-line JSON objects. Every request may carry an "id", which is echoed in its response.
+     * The "command" is one of
+     * - "create", "update", "score", "save", "load", "remake" and "close", each naming its "session",
+     * - "stats", which reports the number of sessions and the latency percentiles.
+     *
+     * "update" and "score" take the "functions" as an array of strings, which "score" evaluates only as far as needed.
+     * Without functions, "score" reports the current state. "save" and "load" take the "file",
+     * a plain name of letters, digits, '.', '-' and '_' not starting with '.', which the repository resolves inside its directory.
+     *
+     * The requests of a session are executed one at a time in the order of submission,
+     * while the requests of different sessions are executed concurrently.
+     */
+    class SessionManager final
+    {
+    public:
+        /*!
+         * \brief LatencySampleCount is the number of most recent requests the latency percentiles are taken over.
+         */
+        constexpr static const size_t LatencySampleCount = 4096;
+
+    private:
+        struct Request
+        {
+            std::shared_ptr<rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>>> document;
+            std::function<void(const std::wstring&)> respond;
+            std::chrono::steady_clock::time_point submitted;
+        };
+
+        struct Session
+        {
+            std::unique_ptr<Game> game;
+            std::deque<Request> requests;
+            bool isScheduled;
+        };
+
+        std::shared_ptr<DotGenerator> dotGenerator;
+        std::shared_ptr<Repository> repository;
+        unsigned long int functionLimit;
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::condition_variable idle;
+        std::map<std::wstring, std::shared_ptr<Session>> sessions;
+        std::deque<std::shared_ptr<Session>> readySessions;
+        size_t outstandingCount;
+        bool isStopping;
+
+        std::mutex dotGeneratorMutex;
+
+        std::mutex latencyMutex;
+        std::vector<double> latencies;
+        unsigned long int completedCount;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param dotGenerator The generator of the dots of new games, shared by all sessions.
+         * \param repository The repository used to persist games, which must allow concurrent use.
+         * \param workerCount The number of threads executing requests, 0 meaning one per core.
+         * \param functionLimit The number of functions evaluated per game, further ones are ignored.
+         */
+        SessionManager(std::shared_ptr<DotGenerator> dotGenerator = std::make_shared<RandomDotGenerator>(8, 2),
+                       std::shared_ptr<Repository> repository = std::make_shared<DiskRepository>(),
+                       unsigned int workerCount = 0,
+                       unsigned long int functionLimit = Game::DefaultFunctionLimit);
+
+        /*!
+         * \brief Executes the requests already submitted and stops the worker threads.
+         */
+        ~SessionManager();
+        SessionManager(const SessionManager&) = delete;
+        SessionManager(SessionManager&&) = delete;
+        SessionManager& operator=(const SessionManager&) = delete;
+        SessionManager& operator=(SessionManager&&) = delete;
+
+        /*!
+         * \brief Submit hands a request to the sessions, safe to call from any thread.
+         *
+         * Malformed requests, requests for unknown sessions and "stats" are answered immediately on the calling thread,
+         * all other requests on a worker thread.
+         * \param requestLine The request as a single-line JSON object.
+         * \param respond The function accepting the response as a single-line JSON object.
+         */
+        void Submit(const std::wstring & requestLine, std::function<void(const std::wstring&)> respond);
+
+        /*!
+         * \brief WaitUntilIdle waits until all requests submitted so far are answered.
+         */
+        void WaitUntilIdle();
+
+        /*!
+         * \brief GetSessionCount gets the number of open sessions.
+         * \return The count.
+         */
+        size_t GetSessionCount();
+
+        /*!
+         * \brief GetWorkerCount gets the number of threads executing requests.
+         * \return The count.
+         */
+        unsigned int GetWorkerCount() const;
+
+        /*!
+         * \brief GetCompletedCount gets the number of requests answered by a worker thread.
+         * \return The count.
+         */
+        unsigned long int GetCompletedCount();
+
+        /*!
+         * \brief GetLatencyPercentile gets the time from submission to response that the given share of the recent requests stayed within.
+         * \param percentile The share in percent, from 0 to 100.
+         * \return The latency in milliseconds, 0 if no request has been answered yet.
+         */
+        double GetLatencyPercentile(double percentile);
+
+    private:
+        void Work();
+        std::wstring Execute(Session & session, const Request & request);
+        void Complete(const Request & request, const std::wstring & response);
+        std::wstring GetStats(const rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> & document);
+    };
+
+}
+
+#endif // SESSIONMANAGER_H
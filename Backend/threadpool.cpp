@@ -0,0 +1,141 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace Backend {
+
+    ThreadPool::ThreadPool(unsigned int threadCount)
+        : task(nullptr),
+          taskCount(0),
+          nextTask(0),
+          busyWorkers(0),
+          batch(0),
+          isStopping(false)
+    {
+        if(threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // the calling thread works on each batch, too
+        for(unsigned int i = 1; i < threadCount; ++i)
+        {
+            this->workers.emplace_back(&ThreadPool::Work, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->isStopping = true;
+        }
+
+        this->wakeUp.notify_all();
+
+        for(auto & worker : this->workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::ForEach(size_t taskCount, const std::function<void(size_t)> & task)
+    {
+        // one batch at a time
+        std::lock_guard<std::mutex> batchLock(this->batchMutex);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->task = &task;
+            this->taskCount = taskCount;
+            this->nextTask = 0;
+            this->busyWorkers = this->workers.size();
+            this->firstException = nullptr;
+            ++this->batch;
+        }
+
+        this->wakeUp.notify_all();
+        this->RunTasks();
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->batchDone.wait(lock, [this]{ return this->busyWorkers == 0; });
+        this->task = nullptr;
+
+        if(this->firstException)
+        {
+            std::rethrow_exception(this->firstException);
+        }
+    }
+
+    unsigned int ThreadPool::GetThreadCount() const
+    {
+        return static_cast<unsigned int>(this->workers.size()) + 1;
+    }
+
+    void ThreadPool::Work()
+    {
+        unsigned long long lastBatch = 0;
+
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->wakeUp.wait(lock, [&]{ return this->isStopping || this->batch != lastBatch; });
+
+                if(this->isStopping)
+                {
+                    return;
+                }
+
+                lastBatch = this->batch;
+            }
+
+            this->RunTasks();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                --this->busyWorkers;
+            }
+
+            this->batchDone.notify_all();
+        }
+    }
+
+    void ThreadPool::RunTasks()
+    {
+        for(size_t index = this->nextTask++; index < this->taskCount; index = this->nextTask++)
+        {
+            try
+            {
+                (*this->task)(index);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if(!this->firstException)
+                {
+                    this->firstException = std::current_exception();
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace Backend {
+
+    /*!
+     * \class ThreadPool
+     * \brief The ThreadPool class keeps worker threads around to run batches of independent tasks.
+     */
+    class ThreadPool final
+    {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex batchMutex;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::condition_variable batchDone;
+
+        const std::function<void(size_t)> * task;
+        size_t taskCount;
+        std::atomic<size_t> nextTask;
+        size_t busyWorkers;
+        unsigned long long batch;
+        bool isStopping;
+        std::exception_ptr firstException;
+
+    public:
+        /*!
+         * \brief Initializes a new instance with the given number of threads.
+         * \param threadCount The number of threads working on a batch, including the calling one, 0 meaning one per core.
+         */
+        explicit ThreadPool(unsigned int threadCount = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /*!
+         * \brief ForEach runs the task for each index from 0 to \a taskCount - 1 and waits for all of them to finish.
+         *
+         * The tasks run in no particular order and concurrently, so they must not depend on one another.
+         * The first exception thrown by a task is rethrown once all tasks are finished.
+         * \param taskCount The number of tasks.
+         * \param task The task, taking its index.
+         */
+        void ForEach(size_t taskCount, const std::function<void(size_t)> & task);
+
+        /*!
+         * \brief GetThreadCount gets the number of threads working on a batch.
+         * \return The number of worker threads plus the calling one.
+         */
+        unsigned int GetThreadCount() const;
+
+    private:
+        void Work();
+        void RunTasks();
+    };
+
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,160 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "updatescheduler.h"
+
+namespace Backend {
+
+    UpdateScheduler::UpdateScheduler(Game & game)
+        : game(game),
+          isRunning(false),
+          submittedCount(0),
+          droppedCount(0),
+          coalescedCount(0),
+          cancelledCount(0)
+    {
+    }
+
+    bool UpdateScheduler::Submit(const std::vector<std::wstring> & funcStrings,
+                                 std::shared_ptr<CancellationToken> cancellationToken,
+                                 std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ++this->submittedCount;
+
+        if(this->pending)
+        {
+            if(this->pending->funcStrings == funcStrings)
+            {
+                ++this->coalescedCount;
+                return false;
+            }
+
+            ++this->droppedCount;
+            this->pending.reset();
+        }
+        else if(this->running && this->running->funcStrings == funcStrings && !this->running->cancellationToken->IsCancelled())
+        {
+            ++this->coalescedCount;
+            return false;
+        }
+
+        // the running update only produces results about to be replaced
+        if(this->running && !this->running->cancellationToken->IsCancelled())
+        {
+            this->running->cancellationToken->Cancel();
+            ++this->cancelledCount;
+        }
+
+        this->pending = std::make_unique<Request>(Request{ funcStrings, cancellationToken, progress });
+
+        if(this->isRunning)
+        {
+            return false;
+        }
+
+        this->isRunning = true;
+        return true;
+    }
+
+    void UpdateScheduler::Run()
+    {
+        while(true)
+        {
+            Request * request;
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->running = std::move(this->pending);
+
+                if(!this->running)
+                {
+                    this->isRunning = false;
+                    return;
+                }
+
+                request = this->running.get();
+            }
+
+            // submitting only reads the running request, so it is used outside the lock
+            try
+            {
+                this->game.Update(request->funcStrings, request->cancellationToken, request->progress);
+            }
+            catch(...)
+            {
+                // nobody runs the pending request once this run is left, so it is dropped and the next submission runs again
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->running.reset();
+
+                if(this->pending)
+                {
+                    ++this->droppedCount;
+                    this->pending.reset();
+                }
+
+                this->isRunning = false;
+                throw;
+            }
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->running.reset();
+        }
+    }
+
+    void UpdateScheduler::CancelAll()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if(this->pending)
+        {
+            ++this->droppedCount;
+            this->pending.reset();
+        }
+
+        if(this->running)
+        {
+            this->running->cancellationToken->Cancel();
+        }
+    }
+
+    unsigned long int UpdateScheduler::GetSubmittedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->submittedCount;
+    }
+
+    unsigned long int UpdateScheduler::GetDroppedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->droppedCount;
+    }
+
+    unsigned long int UpdateScheduler::GetCoalescedCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->coalescedCount;
+    }
+
+    unsigned long int UpdateScheduler::GetCancelledCount()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->cancelledCount;
+    }
+
+}
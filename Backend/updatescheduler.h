@@ -0,0 +1,122 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef UPDATESCHEDULER_H
+#define UPDATESCHEDULER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "game.h"
+#include "cancellationtoken.h"
+
+namespace Backend {
+
+    /*!
+     * \class UpdateScheduler
+     * \brief The UpdateScheduler class serializes the updates of a game, keeping at most one running and one pending.
+     *
+     * A request superseding the pending one drops it, and a request with other functions cancels the running one.
+     * A request for the functions already running or pending is coalesced into it.
+     */
+    class UpdateScheduler final
+    {
+    private:
+        struct Request
+        {
+            std::vector<std::wstring> funcStrings;
+            std::shared_ptr<CancellationToken> cancellationToken;
+            std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress;
+        };
+
+        Game & game;
+        std::mutex mutex;
+        std::unique_ptr<Request> running;
+        std::unique_ptr<Request> pending;
+        bool isRunning;
+
+        unsigned long int submittedCount;
+        unsigned long int droppedCount;
+        unsigned long int coalescedCount;
+        unsigned long int cancelledCount;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param game The game to update, which must outlive the scheduler and be updated only through it while it runs.
+         */
+        explicit UpdateScheduler(Game & game);
+        ~UpdateScheduler() = default;
+        UpdateScheduler(const UpdateScheduler&) = delete;
+        UpdateScheduler(UpdateScheduler&&) = delete;
+        UpdateScheduler& operator=(const UpdateScheduler&) = delete;
+        UpdateScheduler& operator=(UpdateScheduler&&) = delete;
+
+        /*!
+         * \brief Submit requests an update of the game with the supplied functions, safe to call from any thread.
+         * \param funcStrings The user-supplied string representations of functions.
+         * \param cancellationToken The token of this request, cancelled if the request becomes obsolete.
+         * \param progress The optional function accepting snapshots of the graphs, see \ref Game::Update.
+         * \return true if no update is running and the caller must call \ref Run, false if a running one picks up the request.
+         */
+        bool Submit(const std::vector<std::wstring> & funcStrings,
+                    std::shared_ptr<CancellationToken> cancellationToken,
+                    std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> progress = nullptr);
+
+        /*!
+         * \brief Run updates the game with the pending requests until there are none left.
+         *
+         * If an update throws, the pending request is dropped and the exception is rethrown, the next \ref Submit returning true again.
+         */
+        void Run();
+
+        /*!
+         * \brief CancelAll drops the pending request and cancels the running one.
+         */
+        void CancelAll();
+
+        /*!
+         * \brief Gets the number of requests submitted.
+         * \return The count.
+         */
+        unsigned long int GetSubmittedCount();
+
+        /*!
+         * \brief Gets the number of pending requests dropped before they ran.
+         * \return The count.
+         */
+        unsigned long int GetDroppedCount();
+
+        /*!
+         * \brief Gets the number of requests coalesced into an identical running or pending one.
+         * \return The count.
+         */
+        unsigned long int GetCoalescedCount();
+
+        /*!
+         * \brief Gets the number of running updates cancelled because they became obsolete.
+         * \return The count.
+         */
+        unsigned long int GetCancelledCount();
+    };
+
+}
+
+#endif // UPDATESCHEDULER_H
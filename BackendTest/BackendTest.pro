@@ -32,10 +32,16 @@ HEADERS += \
         subsetgenerator.h \
         testexpressionbuilder.h \
         tst_basex.h \
+        tst_batchgrader.h \
+        tst_boardspec.h \
+        tst_cancellationtoken.h \
         tst_constant.h \
         tst_deserializer.h \
+        tst_discontinuitylocator.h \
         tst_diskrepository.h \
         tst_dot.h \
+        tst_dotgrid.h \
+        tst_dotset.h \
         tst_equality.h \
         tst_evaluating.h \
         tst_evaluator.h \
@@ -43,14 +49,24 @@ HEADERS += \
         tst_functions.h \
         tst_fundamental.h \
         tst_game.h \
+        tst_gameslot.h \
+        tst_gamesnapshot.h \
+        tst_graphdecimator.h \
+        tst_graphtilecache.h \
+        tst_hitscore.h \
         tst_memoryrepository.h \
         tst_parser.h \
         tst_power.h \
         tst_printingtest.h \
+        tst_prefetchingdotgenerator.h \
         tst_product.h \
+        tst_progressiveevaluator.h \
         tst_randomdotgenerator.h \
+        tst_sessionmanager.h \
         tst_subsetgenerator.h \
-        tst_sum.h
+        tst_sum.h \
+        tst_threadpool.h \
+        tst_updatescheduler.h
 
 SOURCES += \
         main.cpp \
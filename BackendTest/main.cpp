@@ -35,6 +35,22 @@
 #include "tst_deserializer.h"
 #include "tst_memoryrepository.h"
 #include "tst_diskrepository.h"
+#include "tst_graphtilecache.h"
+#include "tst_cancellationtoken.h"
+#include "tst_progressiveevaluator.h"
+#include "tst_discontinuitylocator.h"
+#include "tst_graphdecimator.h"
+#include "tst_dotgrid.h"
+#include "tst_dotset.h"
+#include "tst_threadpool.h"
+#include "tst_hitscore.h"
+#include "tst_gamesnapshot.h"
+#include "tst_updatescheduler.h"
+#include "tst_batchgrader.h"
+#include "tst_sessionmanager.h"
+#include "tst_boardspec.h"
+#include "tst_gameslot.h"
+#include "tst_prefetchingdotgenerator.h"
 
 #include <gtest/gtest.h>
 
@@ -0,0 +1,237 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_BATCHGRADER_H
+#define TST_BATCHGRADER_H
+
+#include <memory>
+#include <future>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/batchgrader.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace testing;
+using namespace Backend;
+
+namespace
+{
+    // holds the loading of "slow" until "late" is loaded, or gives up after a while
+    class LateReleasingRepository final : public Repository
+    {
+    private:
+        std::shared_ptr<MemoryRepository> storage;
+        std::promise<void> lateLoaded;
+        std::shared_future<void> isLateLoaded;
+
+    public:
+        explicit LateReleasingRepository(std::shared_ptr<MemoryRepository> storage)
+            : Repository(DeSerializer()),
+              storage(storage),
+              isLateLoaded(lateLoaded.get_future().share())
+        {
+        }
+
+        virtual std::pair<bool, std::wstring> Save(const Game& game, const std::wstring& identifier)
+        {
+            return this->storage->Save(game, identifier);
+        }
+
+        virtual std::pair<bool, std::wstring> Load(const std::wstring& identifier, Game& game)
+        {
+            if(identifier == L"late")
+            {
+                this->lateLoaded.set_value();
+            }
+
+            if(identifier == L"slow" && this->isLateLoaded.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+            {
+                return std::make_pair<bool, std::wstring>(false, std::wstring(L"late game never started"));
+            }
+
+            return this->storage->Load(L"game", game);
+        }
+    };
+}
+
+TEST(BackendTest, BatchGraderShallGradeGamesInOrder)
+{
+    // Arrange
+    auto repository = std::make_shared<MemoryRepository>();
+    Game game(std::make_shared<FixedDotGenerator>(), repository);
+
+    std::vector<std::vector<std::wstring>> exprStrings =
+    {
+        { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" },
+        { L"1/x", L"", L"", L"", L"" },
+        { L"1/x", L"5.05", L"", L"", L"" }
+    };
+
+    std::vector<std::wstring> identifiers;
+    std::vector<int> expectedScores;
+    for(size_t i = 0; i < 11; ++i)
+    {
+        auto identifier = std::wstring(L"game") + std::to_wstring(i);
+        game.Update(exprStrings[i % exprStrings.size()]);
+        game.Save(identifier);
+
+        identifiers.push_back(identifier);
+        expectedScores.push_back(game.GetScore());
+    }
+
+    identifiers.insert(identifiers.begin() + 5, L"missing");
+    expectedScores.insert(expectedScores.begin() + 5, 0);
+
+    BatchGrader grader(repository, 2);
+    std::vector<BatchGrader::Result> results;
+    size_t progressCount = 0;
+
+    // Act
+    auto summary = grader.Grade(identifiers,
+                                [&](const BatchGrader::Result & result) { results.push_back(result); },
+                                [&](const BatchGrader::Summary&) { ++progressCount; });
+
+    // Assert
+    EXPECT_EQ(2, grader.GetThreadCount());
+    EXPECT_EQ(12, summary.gradedCount);
+    EXPECT_EQ(1, summary.failedCount);
+    EXPECT_GE(progressCount, 2);
+
+    ASSERT_EQ(12, results.size());
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(identifiers[i], results[i].identifier);
+        EXPECT_EQ(i != 5, results[i].isLoaded);
+        EXPECT_EQ(expectedScores[i], results[i].score);
+        EXPECT_EQ(i != 5 ? 5 : 0, results[i].dots.size());
+    }
+
+    EXPECT_EQ(4, results[0].score);
+    EXPECT_EQ(3, results[1].score);
+    EXPECT_LT(results[2].score, 0);
+    EXPECT_TRUE(results[2].dots[4].IsActive());
+    EXPECT_FALSE(results[5].error.empty());
+}
+
+TEST(BackendTest, BatchGraderShallGradeGamesOnManyThreads)
+{
+    // Arrange
+    auto repository = std::make_shared<MemoryRepository>();
+    Game game(std::make_shared<FixedDotGenerator>(), repository);
+    game.Update({ L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" });
+    game.Save(L"game");
+
+    BatchGrader grader(repository, 8);
+    std::vector<BatchGrader::Result> results;
+
+    // Act
+    auto summary = grader.Grade(std::vector<std::wstring>(64, L"game"),
+                                [&](const BatchGrader::Result & result) { results.push_back(result); });
+
+    // Assert
+    EXPECT_EQ(64, summary.gradedCount);
+    EXPECT_EQ(0, summary.failedCount);
+    ASSERT_EQ(64, results.size());
+    for(const auto & result : results)
+    {
+        EXPECT_TRUE(result.isLoaded);
+        EXPECT_EQ(4, result.score);
+        EXPECT_EQ(5, result.dots.size());
+    }
+}
+
+TEST(BackendTest, BatchGraderShallKeepGradingPastSlowGame)
+{
+    // Arrange
+    auto storage = std::make_shared<MemoryRepository>();
+    Game game(std::make_shared<FixedDotGenerator>(), storage);
+    game.Save(L"game");
+
+    // with two threads, eight games may be graded ahead, so "late" is reachable while "slow" is still running
+    std::vector<std::wstring> identifiers{ L"game", L"slow", L"game", L"game", L"game", L"game", L"game", L"game", L"late", L"game" };
+    BatchGrader grader(std::make_shared<LateReleasingRepository>(storage), 2);
+    std::vector<BatchGrader::Result> results;
+
+    // Act
+    auto summary = grader.Grade(identifiers,
+                                [&](const BatchGrader::Result & result) { results.push_back(result); });
+
+    // Assert
+    EXPECT_EQ(10, summary.gradedCount);
+    EXPECT_EQ(0, summary.failedCount);
+    ASSERT_EQ(10, results.size());
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(identifiers[i], results[i].identifier);
+        EXPECT_TRUE(results[i].isLoaded);
+    }
+}
+
+TEST(BackendTest, BatchGraderShallStopWhenCancelled)
+{
+    // Arrange
+    auto repository = std::make_shared<MemoryRepository>();
+    Game game(std::make_shared<FixedDotGenerator>(), repository);
+    game.Save(L"game");
+
+    BatchGrader grader(repository, 1);
+    auto cancellationToken = std::make_shared<CancellationToken>();
+    cancellationToken->Cancel();
+    size_t consumedCount = 0;
+
+    // Act
+    auto summary = grader.Grade(std::vector<std::wstring>(10, L"game"),
+                                [&](const BatchGrader::Result&) { ++consumedCount; },
+                                nullptr,
+                                cancellationToken);
+
+    // Assert
+    EXPECT_EQ(0, summary.gradedCount);
+    EXPECT_EQ(0, consumedCount);
+}
+
+TEST(BackendTest, BatchGraderShallFormatResults)
+{
+    // Arrange
+    BatchGrader::Result loaded { L"dir/a \"quoted\" game.qpn", true, L"", 2, { Dot(1.0, 1.0, true), Dot(2.5, -5.0, false), Dot(-4.0, 0.25, true) }, 1.5 };
+    loaded.dots[0].SetIsActive(true);
+    loaded.dots[1].SetIsActive(true);
+
+    BatchGrader::Result failed { L"missing.qpn", false, L"file does not exist: missing.qpn", 0, {}, 0.25 };
+
+    // Act
+    auto loadedCsv = BatchGrader::FormatAsCsv(loaded);
+    auto failedCsv = BatchGrader::FormatAsCsv(failed);
+    auto loadedJson = BatchGrader::FormatAsJson(loaded);
+    auto failedJson = BatchGrader::FormatAsJson(failed);
+
+    // Assert
+    EXPECT_EQ(std::wstring(L"file,loaded,score,goodHit,goodCount,badHit,badCount,milliseconds,dots,error"), BatchGrader::GetCsvHeader());
+    EXPECT_EQ(std::wstring(L"\"dir/a \"\"quoted\"\" game.qpn\",1,2,1,2,1,1,1.500,GBg,\"\""), loadedCsv);
+    EXPECT_EQ(std::wstring(L"\"missing.qpn\",0,0,0,0,0,0,0.250,,\"file does not exist: missing.qpn\""), failedCsv);
+    EXPECT_EQ(std::wstring(L"{\"file\":\"dir/a \\\"quoted\\\" game.qpn\",\"loaded\":true,\"score\":2,\"milliseconds\":1.5,\"dots\":["
+                           L"{\"x\":1.0,\"y\":1.0,\"good\":true,\"hit\":true},"
+                           L"{\"x\":2.5,\"y\":-5.0,\"good\":false,\"hit\":true},"
+                           L"{\"x\":-4.0,\"y\":0.25,\"good\":true,\"hit\":false}],\"error\":\"\"}"), loadedJson);
+    EXPECT_EQ(std::wstring(L"{\"file\":\"missing.qpn\",\"loaded\":false,\"score\":0,\"milliseconds\":0.25,\"dots\":[],\"error\":\"file does not exist: missing.qpn\"}"), failedJson);
+}
+
+#endif // TST_BATCHGRADER_H
@@ -0,0 +1,139 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#if defined(_SKIP_LONG_TEST)
+#elif defined(_USE_LONG_TEST)
+#else
+#error "you need to make a choice between using or skipping long tests, -D_USE_LONG_TEST -D_SKIP_LONG_TEST"
+#endif
+
+#ifndef TST_BOARDSPEC_H
+#define TST_BOARDSPEC_H
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/boardspec.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+#include <chrono>
+
+using namespace testing;
+using namespace Backend;
+
+TEST(BackendTest, BoardSpecShallDescribeClassicBoardByDefault)
+{
+    // Arrange
+    BoardSpec boardSpec;
+
+    // Act, Assert
+    EXPECT_EQ(8, boardSpec.GetGoodDots());
+    EXPECT_EQ(2, boardSpec.GetBadDots());
+    EXPECT_DOUBLE_EQ(-10.5, boardSpec.GetMinX());
+    EXPECT_DOUBLE_EQ(10.5, boardSpec.GetMaxX());
+    EXPECT_EQ(19, boardSpec.GetLatticeLines());
+    EXPECT_DOUBLE_EQ(-9.0, boardSpec.GetLatticeOrigin());
+    EXPECT_DOUBLE_EQ(0.15, boardSpec.GetMaxOffset());
+    EXPECT_DOUBLE_EQ(0.25, boardSpec.GetMinRadius());
+    EXPECT_DOUBLE_EQ(0.25, boardSpec.GetMaxRadius());
+    EXPECT_DOUBLE_EQ(1000.0, boardSpec.GetLimit());
+}
+
+TEST(BackendTest, BoardSpecShallRejectInvalidGeometry)
+{
+    // Act, Assert
+    EXPECT_ANY_THROW(BoardSpec(8, 2, 0.0));
+    EXPECT_ANY_THROW(BoardSpec(8, 2, 10.5, 19, 0.0));
+    EXPECT_ANY_THROW(BoardSpec(300, 62, 10.5, 19));
+    EXPECT_ANY_THROW(BoardSpec(8, 2, 10.5, 19, 1.0, -0.1, 0.25));
+    EXPECT_ANY_THROW(BoardSpec(8, 2, 10.5, 19, 1.0, 0.3, 0.25));
+    EXPECT_ANY_THROW(BoardSpec(8, 2, 10.5, 19, 1.0, 0.25, 0.25, 10.0));
+    EXPECT_NO_THROW(BoardSpec(300, 61, 10.5, 19));
+}
+
+TEST(BackendTest, GameShallEvaluateAcrossWindowOfBoard)
+{
+    // Arrange
+    BoardSpec boardSpec(8, 2, 50.5, 101);
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1, Game::DefaultFunctionLimit, boardSpec);
+
+    // far outside the classic window
+    game.SetDots({ std::make_shared<Dot>(40.0, 8.0, true), std::make_shared<Dot>(-40.0, 8.0, true) });
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"x/5"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    game.Update(exprStrings);
+    auto graphs = game.GetGraphs();
+
+    // Assert
+    EXPECT_DOUBLE_EQ(50.5, game.GetBoardSpec().GetMaxX());
+    ASSERT_EQ(1, graphs[0].size());
+    EXPECT_LE(graphs[0][0].first.front(), -50.0);
+    EXPECT_GE(graphs[0][0].first.back(), 50.0);
+    EXPECT_TRUE(game.GetDots()[0]->IsActive());
+    EXPECT_FALSE(game.GetDots()[1]->IsActive());
+    EXPECT_EQ(1, game.GetScore());
+}
+
+#if defined(_USE_LONG_TEST)
+TEST(BackendTest, GameShallStayInteractiveOnLargeBoard)
+{
+    // Arrange
+    BoardSpec boardSpec(1000, 100, 50.5, 101, 1.0, 0.2, 0.4);
+    Game game(boardSpec, std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"sin(x)*x"),
+        std::wstring(L"1/x"),
+        std::wstring(L"x^2/50-25"),
+        std::wstring(L"10*cos(x/3)"),
+        std::wstring(L"40-x")
+    };
+
+    std::vector<std::wstring> editedExprStrings(exprStrings);
+    editedExprStrings[2] = std::wstring(L"x^2/40-30");
+
+    // Act
+    auto start = std::chrono::steady_clock::now();
+    game.Update(exprStrings);
+    auto fullMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    game.Update(editedExprStrings);
+    auto editMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Assert
+    RecordProperty("fullUpdateMicroseconds", static_cast<int>(1000.0 * fullMilliseconds));
+    RecordProperty("editUpdateMicroseconds", static_cast<int>(1000.0 * editMilliseconds));
+
+    EXPECT_EQ(1100, game.GetDots().size());
+    EXPECT_LT(fullMilliseconds, 2000.0);
+    EXPECT_LT(editMilliseconds, 500.0);
+}
+#endif // _USE_LONG_TEST
+
+#endif // TST_BOARDSPEC_H
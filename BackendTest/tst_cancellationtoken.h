@@ -0,0 +1,155 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_CANCELLATIONTOKEN_H
+#define TST_CANCELLATIONTOKEN_H
+
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/cancellationtoken.h"
+#include "../Backend/evaluator.h"
+#include "../Backend/game.h"
+#include "../Backend/basex.h"
+#include "../Backend/constant.h"
+#include "../Backend/product.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, CancellationTokenShallReportCancellationAndDeadline)
+{
+    // Arrange
+    CancellationToken plain;
+    CancellationToken generous(std::chrono::milliseconds(60000));
+    CancellationToken exhausted(std::chrono::milliseconds(0));
+
+    // Act
+    auto plainBefore = plain.IsCancelled();
+    plain.Cancel();
+    auto plainAfter = plain.IsCancelled();
+
+    // Assert
+    EXPECT_FALSE(plainBefore);
+    EXPECT_TRUE(plainAfter);
+    EXPECT_FALSE(generous.IsCancelled());
+    EXPECT_TRUE(exhausted.IsCancelled());
+}
+
+TEST(BackendTest, EvaluatorShallStopOnCancellation)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto token = std::make_shared<CancellationToken>();
+    token->Cancel();
+
+    Evaluator evaluator(baseX, -10.5, 10.5, 1000.0, 1.0, token);
+
+    // Act
+    auto graph = evaluator.Evaluate();
+
+    // Assert
+    size_t pointCount = 0;
+    for(auto & branch : graph)
+    {
+        pointCount += branch.first.size();
+    }
+
+    EXPECT_EQ(0, pointCount);
+}
+
+TEST(BackendTest, DotShallReportNoHitOnCancellation)
+{
+    // Arrange
+    auto c = std::make_shared<Constant>(1.0);
+    Dot dot(1.0, 1.0, true);
+
+    Evaluator evaluator(c, -10.5, 10.5, 1000.0);
+    auto graph = evaluator.Evaluate();
+
+    auto token = std::make_shared<CancellationToken>();
+    token->Cancel();
+
+    // Act
+    auto result = dot.CheckForHit(c, graph, token);
+
+    // Assert
+    EXPECT_FALSE(result);
+    EXPECT_FALSE(dot.IsActive());
+}
+
+TEST(BackendTest, GameShallReevaluateFunctionsAfterCancelledUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x-3.0)*(x+4.0)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    auto token = std::make_shared<CancellationToken>();
+    token->Cancel();
+
+    // Act
+    game.Update(exprStrings, token);
+    auto scoreCancelled = game.GetScore();
+
+    game.Update(exprStrings);
+    auto scoreComplete = game.GetScore();
+
+    // Assert
+    EXPECT_EQ(0, scoreCancelled);
+    EXPECT_EQ(3 + 1, scoreComplete);
+}
+
+TEST(BackendTest, GameShallReturnPromptlyWhenCancelledFromAnotherThread)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"sin(1/x)"),
+        std::wstring(L"sin(1/(x-1))"),
+        std::wstring(L"sin(1/(x-2))"),
+        std::wstring(L"sin(1/(x-3))"),
+        std::wstring(L"sin(1/(x-4))")
+    };
+
+    auto token = std::make_shared<CancellationToken>();
+
+    // Act
+    auto start = std::chrono::steady_clock::now();
+    std::thread worker([&](){ game.Update(exprStrings, token); });
+    token->Cancel();
+    worker.join();
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    // Assert
+    EXPECT_LT(duration, std::chrono::milliseconds(1000));
+}
+
+#endif // TST_CANCELLATIONTOKEN_H
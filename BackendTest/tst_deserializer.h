@@ -25,6 +25,7 @@
 #include "../Backend/deserializer.h"
 #include "../Backend/game.h"
 #include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
 #include "../TestHelper/doublehelper.h"
 
 #include <sstream>
@@ -323,4 +324,29 @@ TEST(BackendTest, DeserializationSerializationRoundtripShouldWorkCorrectly)
     EXPECT_STREQ(L"", functionsFromPersistence[4].c_str());
 }
 
+TEST(BackendTest, DeserializationShouldFitFunctionsToFunctionLimitOfGame)
+{
+    // Arrange
+    std::wstring json(LR"foo({"dataVersion":"1","dots":[{"x":1.0,"y":1.0,"radius":0.25,"kind":"good"}],"functions":["1/x","(x-3.0)*(x+4.0)","(x+8)*(x+4)*(x-1)"]})foo");
+    std::wstringstream fewSs(json);
+    std::wstringstream manySs(json);
+
+    DeSerializer ds;
+    Game fewGame(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1, 2);
+    Game manyGame(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1, 8);
+
+    // Act
+    auto fewResult = ds.Deserialize(fewSs, fewGame);
+    auto manyResult = ds.Deserialize(manySs, manyGame);
+
+    // Assert
+    ASSERT_TRUE(fewResult.first);
+    ASSERT_TRUE(manyResult.first);
+    ASSERT_EQ(2, fewGame.GetFunctions().size());
+    EXPECT_STREQ(L"(x-3.0)*(x+4.0)", fewGame.GetFunctions()[1].c_str());
+    ASSERT_EQ(8, manyGame.GetFunctions().size());
+    EXPECT_STREQ(L"(x+8)*(x+4)*(x-1)", manyGame.GetFunctions()[2].c_str());
+    EXPECT_STREQ(L"", manyGame.GetFunctions()[7].c_str());
+}
+
 #endif // TST_DESERIALIZER_H
@@ -0,0 +1,156 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_DISCONTINUITYLOCATOR_H
+#define TST_DISCONTINUITYLOCATOR_H
+
+#include <memory>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/discontinuitylocator.h"
+#include "../Backend/evaluator.h"
+#include "../Backend/constant.h"
+#include "../Backend/basex.h"
+#include "../Backend/product.h"
+#include "../Backend/functions.h"
+#include "../Backend/parser.h"
+#include "../TestHelper/countingexpression.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, DiscontinuityLocatorShallLocateDomainEdge)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto ln = std::make_shared<NaturalLogarithm>(baseX);
+    DiscontinuityLocator locator(ln, 1000.0, 1e-8);
+
+    // Act
+    auto boundary = locator.FindInsideAfter(-10.5, 10.5, 1e-2);
+
+    // Assert
+    ASSERT_TRUE(boundary.has_value());
+    EXPECT_EQ(DiscontinuityLocator::Kind::DomainEdge, boundary->kind);
+    EXPECT_LT(0.0, boundary->x);
+    EXPECT_GT(1e-7, boundary->x);
+}
+
+TEST(BackendTest, DiscontinuityLocatorShallLocatePoleButNotZero)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto tangent = std::make_shared<Tangent>(baseX);
+    DiscontinuityLocator locator(tangent, 1e12, 1e-10);
+
+    // Act
+    auto pole = locator.LocatePole(1.5, std::tan(1.5), 1.6, std::tan(1.6));
+    auto zero = locator.LocatePole(-0.1, std::tan(-0.1), 0.1, std::tan(0.1));
+
+    // Assert
+    ASSERT_TRUE(pole.has_value());
+    EXPECT_NEAR(std::acos(0.0), pole.value(), 1e-9);
+    EXPECT_FALSE(zero.has_value());
+}
+
+TEST(BackendTest, EvaluatorShallReportBoundariesAtLimitAroundPole)
+{
+    // Arrange
+    auto constant = std::make_shared<Constant>(1.0);
+    auto baseX = std::make_shared<BaseX>();
+    auto product = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, constant), Product::Factor(Product::Exponent::Negative, baseX)});
+    Evaluator evaluator(product, -10.5, 10.5, 1000.0);
+
+    // Act
+    auto graph = evaluator.Evaluate();
+    auto boundaries = evaluator.GetBoundaries();
+
+    // Assert
+    ASSERT_EQ(2, graph.size());
+    ASSERT_EQ(2, boundaries.size());
+    EXPECT_EQ(DiscontinuityLocator::Kind::Limit, boundaries[0].kind);
+    EXPECT_NEAR(-1e-3, boundaries[0].x, 1e-7);
+    EXPECT_EQ(DiscontinuityLocator::Kind::Limit, boundaries[1].kind);
+    EXPECT_NEAR(1e-3, boundaries[1].x, 1e-7);
+    EXPECT_DOUBLE_EQ(boundaries[0].x, graph[0].first.back());
+    EXPECT_DOUBLE_EQ(boundaries[1].x, graph[1].first.front());
+}
+
+TEST(BackendTest, ForTangentEvaluatorShallReachLimitWithoutCrawlingUpToPoles)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto tangent = std::make_shared<Tangent>(baseX);
+    auto counting = std::make_shared<CountingExpression>(tangent);
+    Evaluator evaluator(counting, -10.5, 10.5, 1000.0);
+
+    // Act
+    auto graph = evaluator.Evaluate();
+
+    // Assert
+    ASSERT_EQ(7, graph.size());
+    for(size_t i = 0; i < graph.size(); ++i)
+    {
+        if(i > 0)
+        {
+            EXPECT_NEAR(1000.0, std::abs(graph[i].second.front()), 1e-2);
+        }
+        if(i < graph.size() - 1)
+        {
+            EXPECT_NEAR(1000.0, std::abs(graph[i].second.back()), 1e-2);
+        }
+    }
+
+    // creeping up to each of the six poles with the smallest increment took more than 20000 evaluations
+    EXPECT_GT(10000, counting->GetEvaluationCount());
+}
+
+TEST(BackendTest, DiscontinuityLocatorShallStopAtSpacingOfDoubles)
+{
+    // Arrange
+    Parser parser;
+    auto expression = parser.Parse(L"1/(x-100000.3)");
+    DiscontinuityLocator locator(expression, 1e9, 1e-14);
+
+    // Act
+    auto edge = locator.LocateEdge(100000.0, 100000.3);
+    auto pole = locator.LocatePole(100000.2, expression->Evaluate(100000.2).value(), 100000.4, expression->Evaluate(100000.4).value());
+
+    // Assert
+    EXPECT_NEAR(100000.3, edge, 1e-5);
+    ASSERT_TRUE(pole.has_value());
+    EXPECT_NEAR(100000.3, pole.value(), 1e-5);
+}
+
+TEST(BackendTest, EvaluatorShallFinishFarFromZeroInFineDetail)
+{
+    // Arrange
+    Parser parser;
+    Evaluator evaluator(parser.Parse(L"1/(x-100000.3)"), 100000, 100001, 1e9, 4096);
+
+    // Act
+    auto graph = evaluator.Evaluate();
+
+    // Assert
+    ASSERT_EQ(2, graph.size());
+    EXPECT_NEAR(100000.3, graph[0].first.back(), 1e-5);
+    EXPECT_NEAR(100000.3, graph[1].first.front(), 1e-5);
+}
+
+#endif // TST_DISCONTINUITYLOCATOR_H
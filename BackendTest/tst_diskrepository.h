@@ -97,6 +97,25 @@ TEST(BackendTest, DiskRepositoryShallCorrectlyRoundtripGame)
     ASSERT_TRUE(std::filesystem::remove(tempFile));
     ASSERT_FALSE(std::filesystem::exists(tempFile));
 }
+
+TEST(BackendTest, DiskRepositoryShallResolveIdentifiersInsideDirectory)
+{
+    // Arrange
+    auto directory = std::filesystem::temp_directory_path();
+    auto tempFile = directory / std::filesystem::path(L"qtpollynom.testing.directory.temp.file");
+    Game game(std::make_shared<FixedDotGenerator>(2));
+    DiskRepository repo(directory.wstring());
+
+    // Act
+    auto resultSave = repo.Save(game, L"qtpollynom.testing.directory.temp.file");
+    auto resultLoad = repo.Load(L"qtpollynom.testing.directory.temp.file", game);
+
+    // Assert
+    ASSERT_TRUE(resultSave.first);
+    ASSERT_TRUE(resultLoad.first);
+    ASSERT_TRUE(std::filesystem::exists(tempFile));
+    ASSERT_TRUE(std::filesystem::remove(tempFile));
+}
 #endif // _USE_LONG_TEST
 
 #endif // TST_DISKREPOSITORY_H
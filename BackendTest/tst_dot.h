@@ -20,6 +20,7 @@
 #define TST_DOT_H
 
 #include <memory>
+#include <cmath>
 #include <gtest/gtest.h>
 #include <gmock/gmock-matchers.h>
 #include "../Backend/evaluator.h"
@@ -30,6 +31,8 @@
 #include "../Backend/sum.h"
 #include "../Backend/functions.h"
 #include "../Backend/power.h"
+#include "../Backend/parser.h"
+#include "../TestHelper/countingexpression.h"
 
 using namespace Backend;
 using namespace testing;
@@ -277,6 +280,163 @@ TEST(BackendTest, DotShallCorrectlyDetermineBeingHitEvenAfterFirstHit)
     EXPECT_TRUE(isActiveAfterC);
 }
 
+TEST(BackendTest, DotShallRefineChordsThatMissWhereTheGraphHits)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    // x*x
+    auto product = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, baseX), Product::Factor(Product::Exponent::Positive, baseX)});
+    auto counting = std::make_shared<CountingExpression>(product);
+
+    Dot dot(0.5, 0.4, true);
+
+    // a single chord from (-1, 1) to (1, 1), far above the dot
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData{
+        std::make_pair(std::vector<double>{-1.0, 1.0}, std::vector<double>{1.0, 1.0})
+    };
+
+    // Act
+    auto result = dot.CheckForHit(counting, graphData);
+
+    // Assert
+    EXPECT_TRUE(result);
+    EXPECT_GE(65, counting->GetEvaluationCount());
+}
+
+TEST(BackendTest, DotShallRefineChordsThatHitWhereTheGraphMisses)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    // x*x
+    auto product = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, baseX), Product::Factor(Product::Exponent::Positive, baseX)});
+    auto counting = std::make_shared<CountingExpression>(product);
+
+    Dot dot(0.0, 1.0, true);
+
+    // a single chord from (-1, 1) to (1, 1), right through the dot
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData{
+        std::make_pair(std::vector<double>{-1.0, 1.0}, std::vector<double>{1.0, 1.0})
+    };
+
+    // Act
+    auto firstResult = dot.CheckForHit(counting, graphData);
+    auto firstCount = counting->GetEvaluationCount();
+    auto secondResult = dot.CheckForHit(counting, graphData);
+    auto secondCount = counting->GetEvaluationCount() - firstCount;
+
+    // Assert
+    EXPECT_FALSE(firstResult);
+    EXPECT_FALSE(secondResult);
+    EXPECT_FALSE(dot.IsActive());
+    EXPECT_GE(65, firstCount);
+    EXPECT_EQ(firstCount, secondCount);
+}
+
+TEST(BackendTest, DotShallNotEvaluateAlongChordsFarAway)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto counting = std::make_shared<CountingExpression>(baseX);
+
+    Evaluator evaluator(baseX, -10.5, 10.5, 1000.0);
+    auto graphData = evaluator.Evaluate();
+
+    Dot dot(1.0, -3.0, true);
+
+    // Act
+    auto result = dot.CheckForHit(counting, graphData);
+
+    // Assert
+    EXPECT_FALSE(result);
+    EXPECT_GE(1, counting->GetEvaluationCount());
+}
+
+TEST(BackendTest, DotShallTellNearMissesFromTouchesOfLineWithBoundedEvaluations)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto counting = std::make_shared<CountingExpression>(baseX);
+
+    // the distance of (a, a + c) to y = x is c / sqrt(2), the closest point not being one of the samples across the dot
+    std::vector<double> distances{ 0.2499, 0.2501, 0.24999999, 0.25000001 };
+    std::vector<bool> reference{ true, false, true, false };
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData;
+    graphData.push_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+
+    for(size_t i = 0; i < distances.size(); ++i)
+    {
+        Dot dot(0.3, 0.3 + distances[i] * std::sqrt(2.0), true);
+        auto countBefore = counting->GetEvaluationCount();
+
+        // Act
+        auto result = dot.CheckForHit(counting, graphData);
+
+        // Assert
+        EXPECT_EQ(reference[i], result) << "distance " << distances[i];
+        EXPECT_GE(64, counting->GetEvaluationCount() - countBefore) << "distance " << distances[i];
+    }
+}
+
+TEST(BackendTest, DotShallTellNearMissesFromTouchesOfParabolaWithBoundedEvaluations)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    // x*x
+    auto product = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, baseX), Product::Factor(Product::Exponent::Positive, baseX)});
+    auto counting = std::make_shared<CountingExpression>(product);
+
+    // place the dot along the normal at (0.7, 0.49), where the curvature radius is well above the dot radius
+    double normalX = -1.4 / std::sqrt(1.0 + 1.4 * 1.4);
+    double normalY = 1.0 / std::sqrt(1.0 + 1.4 * 1.4);
+    std::vector<double> distances{ 0.249, 0.251, -0.249, -0.251 };
+    std::vector<bool> reference{ true, false, true, false };
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData;
+    graphData.push_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+
+    for(size_t i = 0; i < distances.size(); ++i)
+    {
+        Dot dot(0.7 + distances[i] * normalX, 0.49 + distances[i] * normalY, true);
+        auto countBefore = counting->GetEvaluationCount();
+
+        // Act
+        auto result = dot.CheckForHit(counting, graphData);
+
+        // Assert
+        EXPECT_EQ(reference[i], result) << "distance " << distances[i];
+        EXPECT_GE(64, counting->GetEvaluationCount() - countBefore) << "distance " << distances[i];
+    }
+}
+
+TEST(BackendTest, DotShallFindHitsInScatteredDomainReproducibly)
+{
+    // Arrange
+    Parser parser;
+
+    // defined only on [0.02, 0.04], between the samples across the dot
+    auto narrow = parser.Parse(L"(0.0001-(x-0.03)^2)^0.5");
+    ASSERT_TRUE(narrow);
+    auto counting = std::make_shared<CountingExpression>(narrow);
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData;
+    graphData.push_back(std::make_pair(std::vector<double>(), std::vector<double>()));
+
+    Dot dot(0.0, 0.0, true);
+
+    // Act
+    auto firstResult = dot.CheckForHit(counting, graphData);
+    auto firstCount = counting->GetEvaluationCount();
+    auto secondResult = dot.CheckForHit(counting, graphData);
+    auto secondCount = counting->GetEvaluationCount() - firstCount;
+
+    // Assert
+    EXPECT_TRUE(firstResult);
+    EXPECT_TRUE(secondResult);
+    EXPECT_EQ(firstCount, secondCount);
+    EXPECT_GE(64, firstCount);
+}
+
 TEST(BackendTest, DotShallThrowOnNegativeRadius)
 {
     try
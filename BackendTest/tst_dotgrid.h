@@ -0,0 +1,116 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_DOTGRID_H
+#define TST_DOTGRID_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/dotgrid.h"
+#include "../Backend/randomdotgenerator.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, DotGridShallThrowOnNonPositiveCellSize)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{ std::make_shared<Dot>(0.0, 0.0) };
+
+    // Act & Assert
+    EXPECT_ANY_THROW(DotGrid(dots, 0.0));
+}
+
+TEST(BackendTest, DotGridShallOfferOnlyDotsNearGraphAsCandidates)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{
+        std::make_shared<Dot>(-5.0, 1.1),
+        std::make_shared<Dot>(-5.0, -5.0),
+        std::make_shared<Dot>(3.0, 0.8),
+        std::make_shared<Dot>(8.0, 8.0)
+    };
+    DotGrid grid(dots);
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> horizontalLine{
+        std::make_pair(std::vector<double>{-10.0, -2.0, 6.0, 10.0}, std::vector<double>{1.0, 1.0, 1.0, 1.0})
+    };
+
+    // Act
+    auto candidates = grid.GetCandidates(horizontalLine);
+
+    // Assert
+    EXPECT_THAT(candidates, ElementsAre(0, 2));
+}
+
+TEST(BackendTest, DotGridShallOfferDotsTouchedBySinglePointsAndNothingForEmptyGraphs)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{
+        std::make_shared<Dot>(1.0, 1.0),
+        std::make_shared<Dot>(2.0, 1.0)
+    };
+    DotGrid grid(dots);
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> singlePoint{
+        std::make_pair(std::vector<double>(), std::vector<double>()),
+        std::make_pair(std::vector<double>{2.1}, std::vector<double>{0.9})
+    };
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> empty;
+
+    // Act
+    auto singlePointCandidates = grid.GetCandidates(singlePoint);
+    auto emptyCandidates = grid.GetCandidates(empty);
+
+    // Assert
+    EXPECT_THAT(singlePointCandidates, ElementsAre(1));
+    EXPECT_TRUE(emptyCandidates.empty());
+}
+
+TEST(BackendTest, DotGridShallOfferDotsTheGraphMayStrayToBetweenPoints)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{
+        std::make_shared<Dot>(0.0, 3.0),
+        std::make_shared<Dot>(0.0, 9.0)
+    };
+    DotGrid grid(dots);
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> longChord{
+        std::make_pair(std::vector<double>{-4.0, 4.0}, std::vector<double>{0.0, 0.0})
+    };
+
+    // Act
+    auto candidates = grid.GetCandidates(longChord);
+
+    // Assert
+    EXPECT_THAT(candidates, ElementsAre(0));
+}
+
+TEST(BackendTest, DotGridShallAlignWithRandomDotLattice)
+{
+    // Arrange
+    RandomDotGenerator generator(150, 50);
+    auto dots = generator.Generate();
+
+    // Act
+    DotGrid grid(dots);
+
+    // Assert
+    EXPECT_GE(20 * 20, grid.GetCellCount());
+}
+
+#endif // TST_DOTGRID_H
@@ -0,0 +1,138 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_DOTSET_H
+#define TST_DOTSET_H
+
+#include <memory>
+#include <random>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/dotset.h"
+#include "../Backend/randomdotgenerator.h"
+#include "../Backend/mathhelper.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, DotSetShallFindSameHitsAsTestingEachDot)
+{
+    // Arrange
+    RandomDotGenerator generator(37, 14);
+    auto dots = generator.Generate();
+    DotSet dotSet(dots);
+
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> distribution(-10.5, 10.5);
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData(3);
+    for(auto & branch : graphData)
+    {
+        for(int i = 0; i < 700; ++i)
+        {
+            branch.first.emplace_back(distribution(engine));
+            branch.second.emplace_back(distribution(engine));
+        }
+    }
+
+    // Act
+    auto isHit = dotSet.FindDotsHitBySamples(graphData);
+
+    // Assert
+    ASSERT_EQ(dots.size(), isHit.size());
+    for(size_t dotIndex = 0; dotIndex < dots.size(); ++dotIndex)
+    {
+        auto [x, y] = dots[dotIndex]->GetCoordinates();
+        auto r = dots[dotIndex]->GetRadius();
+
+        bool reference = false;
+        for(auto & branch : graphData)
+        {
+            for(size_t i = 0; i < branch.first.size(); ++i)
+            {
+                reference = reference || SquareDistance(branch.first[i], branch.second[i], x, y) <= r * r;
+            }
+        }
+
+        EXPECT_EQ(reference, isHit[dotIndex]) << "dot " << dotIndex;
+    }
+}
+
+TEST(BackendTest, DotSetShallCountSamplesOnTheCircleAsInside)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{
+        std::make_shared<Dot>(0.0, 0.0),
+        std::make_shared<Dot>(1.0, 0.0),
+        std::make_shared<Dot>(5.0, 5.0)
+    };
+    DotSet dotSet(dots);
+
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData{
+        std::make_pair(std::vector<double>(), std::vector<double>()),
+        std::make_pair(std::vector<double>{0.0, 1.25}, std::vector<double>{0.25, 0.0})
+    };
+
+    // Act
+    auto isHit = dotSet.FindDotsHitBySamples(graphData);
+    auto isHitByNothing = dotSet.FindDotsHitBySamples(std::vector<std::pair<std::vector<double>, std::vector<double>>>());
+
+    // Assert
+    EXPECT_THAT(isHit, ElementsAre(true, true, false));
+    EXPECT_THAT(isHitByNothing, ElementsAre(false, false, false));
+}
+
+TEST(BackendTest, DotSetShallMeasureClosestApproachOfChords)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots{
+        std::make_shared<Dot>(0.0, 2.0, true),
+        std::make_shared<Dot>(7.0, 0.0, true),
+        std::make_shared<Dot>(-5.0, 0.0, true),
+        std::make_shared<Dot>(3.0, -1.0, true),
+        std::make_shared<Dot>(0.5, 0.1, false)
+    };
+    DotSet dotSet(dots);
+
+    // a straight line with samples far apart, and a single point
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graphData{
+        { { -5.0, 5.0 }, { 0.0, 0.0 } },
+        { { 3.0 }, { 1.0 } }
+    };
+    std::vector<double> closestSquareDistances;
+
+    // Act
+    auto isHit = dotSet.FindDotsHitBySamples(graphData, closestSquareDistances);
+    std::vector<double> emptySquareDistances;
+    dotSet.FindDotsHitBySamples(std::vector<std::pair<std::vector<double>, std::vector<double>>>(), emptySquareDistances);
+
+    // Assert
+    ASSERT_EQ(dots.size(), closestSquareDistances.size());
+    EXPECT_DOUBLE_EQ(4.0, closestSquareDistances[0]);
+    EXPECT_DOUBLE_EQ(4.0, closestSquareDistances[1]);
+    EXPECT_DOUBLE_EQ(0.0, closestSquareDistances[2]);
+    EXPECT_DOUBLE_EQ(1.0, closestSquareDistances[3]);
+    EXPECT_DOUBLE_EQ(0.01, closestSquareDistances[4]);
+    EXPECT_FALSE(isHit[0]);
+    EXPECT_TRUE(isHit[2]);
+    EXPECT_FALSE(isHit[4]);
+    ASSERT_EQ(dots.size(), emptySquareDistances.size());
+    EXPECT_TRUE(std::isinf(emptySquareDistances[0]));
+}
+
+#endif // TST_DOTSET_H
@@ -611,4 +611,242 @@ TEST(BackendTest, GameShallLoadFromRepository)
     }
 }
 
+TEST(BackendTest, GameShallKeepHitsOfUnchangedFunctionsAndForgetThemForNewDots)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    Game freshGame(std::make_shared<FixedDotGenerator>());
+
+    std::vector<std::wstring> exprStrings1 =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x-3.0)*(x+4.0)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    std::vector<std::wstring> exprStrings2 =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x+8)*(x+4)*(x-1)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    std::vector<std::shared_ptr<Dot>> newDots{
+        std::make_shared<Dot>(5.0, 0.2, true),
+        std::make_shared<Dot>(3.0, 5.0, true)
+    };
+
+    // Act 1
+    game.Update(exprStrings1);
+    game.Update(exprStrings2);
+    freshGame.Update(exprStrings2);
+
+    // Assert 1
+    auto dots = game.GetDots();
+    auto freshDots = freshGame.GetDots();
+    ASSERT_EQ(freshDots.size(), dots.size());
+    for(size_t i = 0; i < dots.size(); ++i)
+    {
+        EXPECT_EQ(freshDots[i]->IsActive(), dots[i]->IsActive()) << "dot " << i;
+    }
+    EXPECT_EQ(freshGame.GetScore(), game.GetScore());
+
+    // Act 2
+    game.SetDots(newDots);
+    game.Update(exprStrings2);
+
+    // Assert 2
+    EXPECT_TRUE(newDots[0]->IsActive());
+    EXPECT_FALSE(newDots[1]->IsActive());
+    EXPECT_EQ(1, game.GetScore());
+}
+
+TEST(BackendTest, GameShallSkipEvaluationInScoreOnlyUpdateWhenBadDotIsHit)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    Game fullGame(std::make_shared<FixedDotGenerator>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"x+2.5"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    auto report = game.UpdateScoreOnly(exprStrings);
+    fullGame.Update(exprStrings);
+
+    // Assert
+    EXPECT_EQ(-1, report.score);
+    EXPECT_EQ(fullGame.GetScore(), report.score);
+    EXPECT_EQ(-1, game.GetScore());
+    EXPECT_TRUE(game.GetDots()[4]->IsActive());
+    EXPECT_EQ(0, report.functionsEvaluated);
+    EXPECT_EQ(2, report.functionsSkipped);
+    EXPECT_EQ(2 * 4, report.dotChecksSkipped);
+    EXPECT_FALSE(report.isCancelled);
+}
+
+TEST(BackendTest, GameShallScoreLikeFullUpdateInScoreOnlyUpdateWhenNoBadDotIsHit)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    Game fullGame(std::make_shared<FixedDotGenerator>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x-3.0)*(x+4.0)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    auto report = game.UpdateScoreOnly(exprStrings);
+    fullGame.Update(exprStrings);
+
+    // Assert
+    EXPECT_EQ(3 + 1, report.score);
+    EXPECT_EQ(fullGame.GetScore(), report.score);
+    EXPECT_EQ(2, report.functionsEvaluated);
+    EXPECT_EQ(0, report.functionsSkipped);
+    EXPECT_EQ(0, report.dotChecksSkipped);
+    EXPECT_EQ(2 * 1, report.windowsEvaluated);
+    EXPECT_FALSE(report.isCancelled);
+    for(size_t i = 0; i < game.GetDots().size(); ++i)
+    {
+        EXPECT_EQ(fullGame.GetDots()[i]->IsActive(), game.GetDots()[i]->IsActive()) << "dot " << i;
+    }
+}
+
+TEST(BackendTest, GameShallKeepMarginsOfGraphsToDots)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L""),
+        std::wstring(L"1"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    game.Update(exprStrings);
+
+    // Assert
+    auto dots = game.GetDots();
+    EXPECT_TRUE(dots[0]->IsActive());
+    EXPECT_LE(game.GetMargin(1, 0), dots[0]->GetRadius());
+    EXPECT_NEAR(1.25, game.GetMargin(1, 1), 1e-6);
+    EXPECT_NEAR(0.65, game.GetMargin(1, 2), 1e-6);
+    EXPECT_NEAR(6.0, game.GetMargin(1, 3), 1e-6);
+    EXPECT_NEAR(4.0, game.GetMargin(1, 4), 1e-6);
+    EXPECT_TRUE(std::isinf(game.GetMargin(0, 0)));
+    EXPECT_TRUE(std::isinf(game.GetMargin(5, 0)));
+    EXPECT_TRUE(std::isinf(game.GetMargin(1, dots.size())));
+}
+
+TEST(BackendTest, GameShallEvaluateFunctionsUpToItsFunctionLimit)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 0, 70);
+
+    std::vector<std::wstring> exprStrings(72, std::wstring(L"x+100"));
+    exprStrings[3] = L"";
+    exprStrings[66] = L"1";
+    exprStrings[68] = L"0.35";
+    exprStrings[71] = L"x";
+
+    // Act
+    game.Update(exprStrings);
+
+    // Assert
+    auto dots = game.GetDots();
+    EXPECT_EQ(70, game.GetFunctionLimit());
+    EXPECT_EQ(70, game.GetGraphs().size());
+    EXPECT_TRUE(dots[0]->IsActive());
+    EXPECT_FALSE(dots[1]->IsActive());
+    EXPECT_TRUE(dots[2]->IsActive());
+    EXPECT_EQ(1 + 1, game.GetScore());
+    EXPECT_LE(game.GetMargin(68, 2), dots[2]->GetRadius());
+    EXPECT_NEAR(0.65, game.GetMargin(66, 2), 1e-6);
+    EXPECT_TRUE(std::isinf(game.GetMargin(71, 0)));
+    EXPECT_ANY_THROW(Game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 0, 0));
+}
+
+TEST(BackendTest, GameShallPublishChangedFunctionsWithoutGraphsInScoreOnlyUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    game.Update({ L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" });
+    auto previous = game.GetSnapshot();
+
+    std::vector<std::wstring> exprStrings{ L"1/x", L"x+2.5", L"", L"", L"" };
+
+    // Act
+    auto report = game.UpdateScoreOnly(exprStrings);
+    auto snapshot = game.GetSnapshot();
+    auto changes = snapshot->GetChangesSince(*previous);
+
+    // Assert
+    EXPECT_EQ(-1, report.score);
+    EXPECT_EQ(exprStrings, snapshot->GetFunctions());
+    EXPECT_EQ(previous->GetGraph(0), snapshot->GetGraph(0));
+    EXPECT_TRUE(snapshot->GetGraph(1).empty());
+    EXPECT_THAT(changes.changedGraphs, ElementsAre(1));
+    EXPECT_TRUE(game.GetDots()[4]->IsActive());
+    EXPECT_EQ(-1, snapshot->GetScore());
+}
+
+TEST(BackendTest, GameShallFindBadDotHitBetweenProbesInScoreOnlyUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    Game fullGame(std::make_shared<FixedDotGenerator>());
+
+    // crosses the bad dot at (2.5, 5.0) steeply between its center and right edge, far from it at both
+    std::vector<std::wstring> exprStrings{ L"40*x-100", L"", L"", L"", L"" };
+
+    // Act
+    auto report = game.UpdateScoreOnly(exprStrings);
+    fullGame.Update(exprStrings);
+
+    // Assert
+    EXPECT_EQ(-1, report.score);
+    EXPECT_EQ(fullGame.GetScore(), report.score);
+    EXPECT_EQ(1, report.windowsEvaluated);
+    EXPECT_EQ(1, report.functionsSkipped);
+}
+
+TEST(BackendTest, GameShallLeaveGameAsItWasWhenScoreOnlyUpdateIsCancelled)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>());
+    game.Update({ L"1/x", L"", L"", L"", L"" });
+    auto previous = game.GetSnapshot();
+    auto cancellationToken = std::make_shared<CancellationToken>();
+    cancellationToken->Cancel();
+
+    // Act
+    auto report = game.UpdateScoreOnly({ L"1/x", L"x+2.5", L"", L"", L"" }, cancellationToken);
+
+    // Assert
+    EXPECT_TRUE(report.isCancelled);
+    EXPECT_EQ(0, report.windowsEvaluated);
+    EXPECT_EQ(previous, game.GetSnapshot());
+    EXPECT_EQ(previous->GetFunctions(), game.GetFunctions());
+}
+
 #endif // TST_GAME_H
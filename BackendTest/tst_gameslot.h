@@ -0,0 +1,67 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_GAMESLOT_H
+#define TST_GAMESLOT_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/gameslot.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, GameSlotShallShareGraphWithHits)
+{
+    // Arrange
+    auto graph = std::make_shared<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>(
+                std::vector<std::pair<std::vector<double>, std::vector<double>>>{ { { 0.0, 1.0 }, { 0.0, 1.0 } } });
+    GameSlot slot(L"x", graph);
+
+    // Act
+    auto checked = slot.WithHits(L"x", { 0, 2 }, { 0.1f, 0.0f, 0.2f });
+
+    // Assert
+    EXPECT_FALSE(slot.IsCheckedFor(L"x"));
+    EXPECT_TRUE(slot.GetDotsHit().empty());
+    EXPECT_EQ(graph, checked->GetGraphHandle());
+    EXPECT_EQ(L"x", checked->GetEvaluatedFunction());
+    EXPECT_TRUE(checked->IsCheckedFor(L"x"));
+    EXPECT_FALSE(checked->IsCheckedFor(L"x+1"));
+    EXPECT_THAT(checked->GetDotsHit(), ElementsAre(0, 2));
+    EXPECT_THAT(checked->GetMargins(), ElementsAre(0.1f, 0.0f, 0.2f));
+}
+
+TEST(BackendTest, EmptyGameSlotShallHoldNothing)
+{
+    // Arrange
+    auto empty = GameSlot::GetEmpty();
+
+    // Act
+    auto checked = empty->WithHits(L"", {}, {});
+
+    // Assert
+    EXPECT_EQ(empty, GameSlot::GetEmpty());
+    EXPECT_NE(nullptr, empty->GetGraphHandle());
+    EXPECT_TRUE(empty->GetGraph().empty());
+    EXPECT_TRUE(empty->GetEvaluatedFunction().empty());
+    EXPECT_FALSE(checked->IsCheckedFor(L""));
+}
+
+#endif // TST_GAMESLOT_H
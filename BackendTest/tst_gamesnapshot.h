@@ -0,0 +1,304 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_GAMESNAPSHOT_H
+#define TST_GAMESNAPSHOT_H
+
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/game.h"
+#include "../Backend/gamesnapshot.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, GameSnapshotShallKeepStateOfItsUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings1 =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x-3.0)*(x+4.0)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    std::vector<std::wstring> exprStrings2 =
+    {
+        std::wstring(L"x+2.5"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    auto initial = game.GetSnapshot();
+    game.Update(exprStrings1);
+    auto first = game.GetSnapshot();
+    game.Update(exprStrings2);
+    auto second = game.GetSnapshot();
+    game.Clear();
+    auto cleared = game.GetSnapshot();
+
+    // Assert
+    EXPECT_EQ(0, initial->GetScore());
+    EXPECT_TRUE(initial->GetGraphs().empty());
+    ASSERT_EQ(5, initial->GetDots().size());
+
+    EXPECT_EQ(3 + 1, first->GetScore());
+    EXPECT_EQ(exprStrings1, first->GetFunctions());
+    ASSERT_EQ(5, first->GetGraphs().size());
+    EXPECT_FALSE(first->GetGraphs()[0].empty());
+    EXPECT_TRUE(first->GetDots()[0]->IsActive());
+    EXPECT_FALSE(first->GetDots()[4]->IsActive());
+
+    EXPECT_EQ(-1, second->GetScore());
+    EXPECT_TRUE(second->GetDots()[4]->IsActive());
+    EXPECT_FALSE(second->GetDots()[0]->IsActive());
+
+    EXPECT_EQ(0, cleared->GetScore());
+    EXPECT_TRUE(cleared->GetFunctions().empty());
+    EXPECT_FALSE(std::any_of(cleared->GetDots().begin(), cleared->GetDots().end(), [](auto dot){ return dot->IsActive(); }));
+}
+
+TEST(BackendTest, GameSnapshotShallBeReadableWhileGameUpdates)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::vector<std::wstring>> exprStrings =
+    {
+        { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" },
+        { L"x+2.5", L"", L"", L"", L"" },
+        { L"", L"", L"", L"", L"" }
+    };
+    std::vector<int> scores{ 3 + 1, -1, 0 };
+
+    std::atomic<bool> isDone(false);
+    std::atomic<int> inconsistentReads(0);
+    std::atomic<int> reads(0);
+
+    // Act
+    std::thread reader([&]()
+    {
+        while(!isDone)
+        {
+            auto snapshot = game.GetSnapshot();
+            auto & functions = snapshot->GetFunctions();
+
+            for(size_t i = 0; i < exprStrings.size(); ++i)
+            {
+                if(functions == exprStrings[i] && snapshot->GetScore() != scores[i])
+                {
+                    ++inconsistentReads;
+                }
+            }
+
+            ++reads;
+        }
+    });
+
+    for(int round = 0; round < 10; ++round)
+    {
+        game.Update(exprStrings[static_cast<size_t>(round) % exprStrings.size()]);
+    }
+
+    isDone = true;
+    reader.join();
+
+    // Assert
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(0, inconsistentReads);
+}
+
+TEST(BackendTest, GameShallReturnChangesOfUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings1 =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    std::vector<std::wstring> exprStrings2 =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L"(x-3.0)*(x+4.0)"),
+        std::wstring(L""),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    // Act
+    auto changes1 = game.Update(exprStrings1);
+    auto changes2 = game.Update(exprStrings2);
+    auto changes3 = game.Update(exprStrings2);
+    auto beforeNewDots = game.GetSnapshot();
+    game.SetDots(std::vector<std::shared_ptr<Dot>>{ std::make_shared<Dot>(0.0, 0.0) });
+    game.Update(exprStrings2);
+    auto changes4 = game.GetSnapshot()->GetChangesSince(*beforeNewDots);
+
+    // Assert
+    EXPECT_THAT(changes1.changedGraphs, ElementsAre(0));
+    EXPECT_THAT(changes1.changedDots, ElementsAre(0, 1));
+    EXPECT_FALSE(changes1.areDotsReplaced);
+    EXPECT_TRUE(changes1.isScoreChanged);
+    EXPECT_EQ(3, changes1.score);
+
+    EXPECT_THAT(changes2.changedGraphs, ElementsAre(1));
+    EXPECT_THAT(changes2.changedDots, ElementsAre(2));
+    EXPECT_TRUE(changes2.isScoreChanged);
+    EXPECT_EQ(3 + 1, changes2.score);
+
+    EXPECT_TRUE(changes3.changedGraphs.empty());
+    EXPECT_TRUE(changes3.changedDots.empty());
+    EXPECT_FALSE(changes3.isScoreChanged);
+
+    EXPECT_TRUE(changes4.areDotsReplaced);
+    EXPECT_TRUE(changes4.changedDots.empty());
+}
+
+TEST(BackendTest, GameShallShareUnchangedSlotsBetweenSnapshots)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings1 = { L"1/x", L"", L"", L"", L"" };
+    std::vector<std::wstring> exprStrings2 = { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+
+    // Act
+    game.Update(exprStrings1);
+    auto first = game.GetSnapshot();
+    game.Update(exprStrings2);
+    auto second = game.GetSnapshot();
+    game.Update(exprStrings2);
+    auto third = game.GetSnapshot();
+
+    // Assert
+    ASSERT_EQ(5, first->GetSlots().size());
+    ASSERT_EQ(5, second->GetSlots().size());
+    EXPECT_EQ(first->GetSlots()[0], second->GetSlots()[0]);
+    EXPECT_NE(first->GetSlots()[1], second->GetSlots()[1]);
+    EXPECT_EQ(second->GetSlots(), third->GetSlots());
+    EXPECT_EQ(&second->GetDots(), &third->GetDots());
+    EXPECT_NE(&first->GetDots(), &second->GetDots());
+}
+
+TEST(BackendTest, GameShallRestoreSnapshot)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings1 = { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+    std::vector<std::wstring> exprStrings2 = { L"x+2.5", L"", L"", L"", L"" };
+
+    game.Update(exprStrings1);
+    auto undoState = game.GetSnapshot();
+    game.Update(exprStrings2);
+
+    // Act
+    auto changes = game.Restore(*undoState);
+    auto restored = game.GetSnapshot();
+
+    // Assert
+    EXPECT_EQ(3 + 1, game.GetScore());
+    EXPECT_EQ(exprStrings1, game.GetFunctions());
+    EXPECT_EQ(undoState->GetSlots(), restored->GetSlots());
+    EXPECT_TRUE(restored->GetDots()[0]->IsActive());
+    EXPECT_FALSE(restored->GetDots()[4]->IsActive());
+
+    EXPECT_THAT(changes.changedGraphs, ElementsAre(0, 1));
+    EXPECT_FALSE(changes.areDotsReplaced);
+    EXPECT_TRUE(changes.isScoreChanged);
+    EXPECT_EQ(3 + 1, changes.score);
+}
+
+TEST(BackendTest, GameShallRestoreSnapshotOfOtherDots)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    std::vector<std::wstring> exprStrings = { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+
+    game.Update(exprStrings);
+    auto undoState = game.GetSnapshot();
+    game.SetDots(std::vector<std::shared_ptr<Dot>>{ std::make_shared<Dot>(0.0, 0.0) });
+    game.Update(exprStrings);
+
+    // Act
+    auto changes = game.Restore(*undoState);
+
+    // Assert
+    EXPECT_TRUE(changes.areDotsReplaced);
+    EXPECT_EQ(3 + 1, game.GetScore());
+    ASSERT_EQ(5, game.GetDots().size());
+    EXPECT_TRUE(game.GetDots()[0]->IsActive());
+}
+
+TEST(BackendTest, GameShallEvaluateWhatIfWithoutChangingItsState)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    std::vector<std::wstring> exprStrings = { L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+    game.Update(exprStrings);
+    auto before = game.GetSnapshot();
+
+    // Act
+    auto worse = game.EvaluateWhatIf(2, L"x+2.5");
+    auto same = game.EvaluateWhatIf(2, L"");
+
+    // Assert
+    ASSERT_NE(nullptr, worse);
+    EXPECT_EQ(-1, worse->GetScore());
+    EXPECT_EQ(L"x+2.5", worse->GetFunctions()[2]);
+    EXPECT_TRUE(worse->GetDots()[4]->IsActive());
+    EXPECT_EQ(before->GetSlots()[0], worse->GetSlots()[0]);
+    EXPECT_EQ(before->GetSlots()[1], worse->GetSlots()[1]);
+
+    ASSERT_NE(nullptr, same);
+    EXPECT_EQ(3 + 1, same->GetScore());
+
+    EXPECT_EQ(before, game.GetSnapshot());
+    EXPECT_EQ(3 + 1, game.GetScore());
+    EXPECT_EQ(exprStrings, game.GetFunctions());
+    EXPECT_FALSE(game.GetDots()[4]->IsActive());
+}
+
+TEST(BackendTest, GameShallRejectWhatIfBeyondFunctionLimit)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    // Act & Assert
+    EXPECT_THROW(game.EvaluateWhatIf(game.GetFunctionLimit(), L"x"), std::exception);
+}
+
+#endif // TST_GAMESNAPSHOT_H
@@ -0,0 +1,96 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_GRAPHDECIMATOR_H
+#define TST_GRAPHDECIMATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/graphdecimator.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, GraphDecimatorShallThrowOnBadParameters)
+{
+    // Arrange, Act & Assert
+    EXPECT_ANY_THROW(GraphDecimator(-10.0, 10.0, 0));
+    EXPECT_ANY_THROW(GraphDecimator(10.0, -10.0, 100));
+}
+
+TEST(BackendTest, GraphDecimatorShallKeepExtremesPerColumn)
+{
+    // Arrange
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graph(1);
+    for(int i = 0; i <= 100000; ++i)
+    {
+        double x = -10.0 + 20.0 * i / 100000.0;
+        graph[0].first.emplace_back(x);
+        graph[0].second.emplace_back(std::sin(50.0 * x));
+    }
+    GraphDecimator decimator(-10.0, 10.0, 100);
+
+    // Act
+    auto decimated = decimator.Decimate(graph);
+
+    // Assert
+    ASSERT_EQ(1, decimated.size());
+    auto & branch = decimated[0];
+    EXPECT_GE(4 * 101, branch.first.size());
+    EXPECT_TRUE(std::is_sorted(branch.first.begin(), branch.first.end()));
+    EXPECT_DOUBLE_EQ(graph[0].first.front(), branch.first.front());
+    EXPECT_DOUBLE_EQ(graph[0].first.back(), branch.first.back());
+
+    // every column of a fast oscillation still covers the full height
+    for(int column = 0; column < 100; ++column)
+    {
+        double lowest = 2.0;
+        double highest = -2.0;
+        for(size_t i = 0; i < branch.first.size(); ++i)
+        {
+            if(-10.0 + 0.2 * column <= branch.first[i] && branch.first[i] < -10.0 + 0.2 * (column + 1))
+            {
+                lowest = std::min(lowest, branch.second[i]);
+                highest = std::max(highest, branch.second[i]);
+            }
+        }
+        EXPECT_GT(-0.99, lowest);
+        EXPECT_LT(0.99, highest);
+    }
+}
+
+TEST(BackendTest, GraphDecimatorShallLeaveSparseBranchesAlone)
+{
+    // Arrange
+    std::vector<std::pair<std::vector<double>, std::vector<double>>> graph{
+        std::make_pair(std::vector<double>{-11.0, -5.0, 0.0}, std::vector<double>{1.0, 2.0, 3.0}),
+        std::make_pair(std::vector<double>(), std::vector<double>()),
+        std::make_pair(std::vector<double>{5.0, 10.5}, std::vector<double>{-1.0, -2.0})
+    };
+    GraphDecimator decimator(-10.0, 10.0, 100);
+
+    // Act
+    auto decimated = decimator.Decimate(graph);
+
+    // Assert
+    EXPECT_EQ(graph, decimated);
+}
+
+#endif // TST_GRAPHDECIMATOR_H
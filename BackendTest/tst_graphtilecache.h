@@ -0,0 +1,208 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_GRAPHTILECACHE_H
+#define TST_GRAPHTILECACHE_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/graphtilecache.h"
+#include "../Backend/game.h"
+#include "../Backend/constant.h"
+#include "../Backend/basex.h"
+#include "../Backend/product.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, GraphTileCacheShallDetermineLevelFromViewport)
+{
+    // Act, Assert
+    EXPECT_EQ(0, GraphTileCache::LevelForViewport(-10.5, 10.5));
+    EXPECT_EQ(0, GraphTileCache::LevelForViewport(-100.0, 100.0));
+    EXPECT_EQ(1, GraphTileCache::LevelForViewport(-5.0, 5.0));
+    EXPECT_EQ(3, GraphTileCache::LevelForViewport(1.0, 3.0));
+    EXPECT_EQ(GraphTileCache::MaxLevel, GraphTileCache::LevelForViewport(1.0, 1.0 + 1e-9));
+}
+
+TEST(BackendTest, GraphTileCacheShallJoinBranchesAcrossTilesButNotAcrossPoles)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto constant = std::make_shared<Constant>(1.0);
+    // x*x
+    auto square = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, baseX), Product::Factor(Product::Exponent::Positive, baseX)});
+    // 1/x
+    auto oneOverX = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, constant), Product::Factor(Product::Exponent::Negative, baseX)});
+
+    GraphTileCache cache;
+
+    // Act
+    auto squareGraph = cache.GetGraph(square, -10.0, 10.0);
+    auto oneOverXGraph = cache.GetGraph(oneOverX, -10.0, 10.0);
+
+    // Assert
+    ASSERT_EQ(1, squareGraph.size());
+    EXPECT_LE(squareGraph[0].first.front(), -10.0 + 0.1);
+    EXPECT_GE(squareGraph[0].first.back(), 10.0 - 0.1);
+    EXPECT_TRUE(std::is_sorted(squareGraph[0].first.begin(), squareGraph[0].first.end()));
+
+    ASSERT_EQ(2, oneOverXGraph.size());
+    EXPECT_LT(oneOverXGraph[0].first.back(), 0.0);
+    EXPECT_GT(oneOverXGraph[1].first.front(), 0.0);
+}
+
+TEST(BackendTest, GraphTileCacheShallOnlyEvaluateNewTilesWhenZooming)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto square = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, baseX), Product::Factor(Product::Exponent::Positive, baseX)});
+
+    GraphTileCache cache;
+
+    // Act
+    cache.GetGraph(square, -10.5, 10.5);
+    auto afterHome = cache.GetTilesEvaluated();
+
+    cache.GetGraph(square, -10.5, 10.5);
+    auto afterHomeAgain = cache.GetTilesEvaluated();
+
+    // level 2, tile width 1.0
+    cache.GetGraph(square, 0.0, 4.0);
+    auto afterZoom = cache.GetTilesEvaluated();
+
+    cache.GetGraph(square, 1.0, 5.0);
+    auto afterPan = cache.GetTilesEvaluated();
+
+    cache.GetGraph(square, -10.5, 10.5);
+    auto afterZoomOut = cache.GetTilesEvaluated();
+
+    // Assert
+    EXPECT_EQ(6, afterHome);
+    EXPECT_EQ(afterHome, afterHomeAgain);
+    EXPECT_EQ(afterHome + 4, afterZoom);
+    EXPECT_EQ(afterZoom + 1, afterPan);
+    EXPECT_EQ(afterPan, afterZoomOut);
+}
+
+TEST(BackendTest, GraphTileCacheShallEvictLeastRecentlyUsedTiles)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+
+    GraphTileCache cache(1000.0, 4);
+
+    // Act
+    cache.GetGraph(baseX, 0.0, 16.0, 0);
+    auto countAfterFirst = cache.GetTileCount();
+    auto evaluatedAfterFirst = cache.GetTilesEvaluated();
+
+    // the tile at index 3 is the most recently used and thus still present
+    cache.GetGraph(baseX, 12.0, 16.0, 0);
+    auto evaluatedAfterRecent = cache.GetTilesEvaluated();
+
+    cache.GetGraph(baseX, 0.0, 4.0, 0);
+    auto evaluatedAfterEvicted = cache.GetTilesEvaluated();
+
+    // Assert
+    EXPECT_EQ(4, countAfterFirst);
+    EXPECT_EQ(4, evaluatedAfterFirst);
+    EXPECT_EQ(evaluatedAfterFirst, evaluatedAfterRecent);
+    EXPECT_EQ(evaluatedAfterRecent, evaluatedAfterEvicted);
+
+    cache.GetGraph(baseX, 16.0, 20.0, 0);
+    cache.GetGraph(baseX, 4.0, 8.0, 0);
+    EXPECT_EQ(6, cache.GetTilesEvaluated());
+    EXPECT_EQ(4, cache.GetTileCount());
+}
+
+TEST(BackendTest, GameShallProvideGraphsForViewport)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L""),
+        std::wstring(L"x^2"),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    game.Update(exprStrings);
+
+    // Act
+    auto graphs = game.GetGraphsForViewport(0.5, 1.5);
+
+    // Assert
+    ASSERT_EQ(game.GetGraphs().size(), graphs.size());
+    ASSERT_GT(graphs[0].size(), 0);
+    EXPECT_LE(graphs[0][0].first.front(), 0.5 + 0.01);
+    EXPECT_GE(graphs[0][0].first.back(), 1.5 - 0.01);
+    EXPECT_TRUE(graphs[1].empty());
+    ASSERT_GT(graphs[2].size(), 0);
+    EXPECT_GT(graphs[2][0].first.size(), game.GetGraphs()[2][0].first.size() / 10);
+}
+
+TEST(BackendTest, GraphTileCacheShallEvaluateOnlyInsideWindow)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    GraphTileCache windowedCache(1000.0, GraphTileCache::DefaultCapacity, -10.5, 10.5);
+    GraphTileCache unboundedCache;
+
+    // Act
+    auto wideGraph = windowedCache.GetGraph(baseX, -1e9, 1e9);
+    auto tilesForWideGraph = windowedCache.GetTilesEvaluated();
+    auto outsideGraph = windowedCache.GetGraph(baseX, 20.0, 30.0);
+
+    // Assert
+    ASSERT_EQ(1, wideGraph.size());
+    EXPECT_LE(wideGraph[0].first.front(), -10.5);
+    EXPECT_GE(wideGraph[0].first.back(), 10.5);
+    EXPECT_EQ(6, tilesForWideGraph);
+
+    ASSERT_EQ(1, outsideGraph.size());
+    EXPECT_TRUE(outsideGraph[0].first.empty());
+    EXPECT_EQ(tilesForWideGraph, windowedCache.GetTilesEvaluated());
+
+    EXPECT_THROW(unboundedCache.GetGraph(baseX, -1e9, 1e9), std::exception);
+    EXPECT_EQ(0, unboundedCache.GetTilesEvaluated());
+}
+
+TEST(BackendTest, GameShallLimitViewportToBoard)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    game.Update({ L"1/x", L"", L"", L"", L"" });
+
+    // Act
+    auto graphs = game.GetGraphsForViewport(-1e9, 1e9);
+
+    // Assert
+    ASSERT_EQ(5, graphs.size());
+    ASSERT_EQ(2, graphs[0].size());
+    EXPECT_LE(graphs[0][0].first.front(), -10.5);
+    EXPECT_GE(graphs[0][1].first.back(), 10.5);
+}
+
+#endif // TST_GRAPHTILECACHE_H
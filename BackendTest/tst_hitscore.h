@@ -0,0 +1,204 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_HITSCORE_H
+#define TST_HITSCORE_H
+
+#include <vector>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/hitscore.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, HitScoreShallScoreSeparateFunctionsIndependently)
+{
+    // Arrange
+    std::vector<std::uint64_t> hitMasks{ 1u, 1u, 0u, 4u, 1u, 16u, 16u };
+
+    // Act
+    auto optimal = GetOptimalHitScore(hitMasks);
+    auto greedy = GetGreedyHitScore(hitMasks);
+
+    // Assert
+    EXPECT_EQ(7 + 1 + 3, optimal);
+    EXPECT_EQ(optimal, greedy);
+    EXPECT_EQ(0, GetOptimalHitScore(std::vector<std::uint64_t>()));
+    EXPECT_EQ(0, GetOptimalHitScore(std::vector<std::uint64_t>{ 0u, 0u }));
+}
+
+TEST(BackendTest, HitScoreShallSaturateForManyDots)
+{
+    // Arrange
+    std::vector<std::uint64_t> thirtyDots(30, 1u);
+    std::vector<std::uint64_t> fortyDots(40, 1u);
+    std::vector<std::uint64_t> sharedDots(40, 3u);
+    sharedDots.push_back(2u);
+
+    // Act
+    auto thirty = GetHitScore(thirtyDots);
+    auto forty = GetHitScore(fortyDots);
+    auto optimalShared = GetOptimalHitScore(sharedDots);
+    auto greedyShared = GetGreedyHitScore(sharedDots);
+
+    // Assert
+    EXPECT_EQ((1 << 30) - 1, thirty);
+    EXPECT_EQ(std::numeric_limits<int>::max(), forty);
+    EXPECT_EQ(std::numeric_limits<int>::max(), optimalShared);
+    EXPECT_EQ(std::numeric_limits<int>::max(), greedyShared);
+}
+
+TEST(BackendTest, GameShallSaturateScoreForManyDotsOnOneGraph)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::shared_ptr<Dot>> dots;
+    for(int i = 0; i < 40; ++i)
+    {
+        dots.push_back(std::make_shared<Dot>(-9.75 + 0.5 * i, 0.0));
+    }
+
+    game.SetDots(dots);
+
+    // Act
+    game.Update({ L"0", L"", L"", L"", L"" });
+
+    // Assert
+    EXPECT_EQ(std::numeric_limits<int>::max(), game.GetScore());
+}
+
+TEST(BackendTest, HitScoreShallFindBetterAssignmentThanGreedy)
+{
+    // Arrange
+    // functions 0, 1 and 3 hit two dots each, greedy takes the first of them and splits the other two
+    std::vector<std::uint64_t> hitMasks{ 3u, 8u, 2u, 9u };
+
+    // Act
+    auto optimal = GetOptimalHitScore(hitMasks);
+    auto greedy = GetGreedyHitScore(hitMasks);
+
+    // Assert
+    EXPECT_EQ(3 + 1 + 1, greedy);
+    EXPECT_EQ(3 + 3, optimal);
+}
+
+TEST(BackendTest, HitScoreShallMatchBestFunctionOrder)
+{
+    // Arrange
+    std::mt19937 generator(20200517);
+    std::uniform_int_distribution<std::uint64_t> maskDistribution(0, 31);
+    std::uniform_int_distribution<int> dotCountDistribution(0, 12);
+    int disagreements(0);
+
+    for(int game = 0; game < 2000; ++game)
+    {
+        std::vector<std::uint64_t> hitMasks(static_cast<size_t>(dotCountDistribution(generator)));
+        std::generate(hitMasks.begin(), hitMasks.end(), [&](){ return maskDistribution(generator); });
+
+        // every function in turn takes all remaining dots it hits
+        std::vector<unsigned int> order{ 0, 1, 2, 3, 4 };
+        int bruteForce(0);
+        do
+        {
+            std::vector<std::uint64_t> remaining(hitMasks);
+            int score(0);
+            for(auto function : order)
+            {
+                int count(0);
+                for(auto & mask : remaining)
+                {
+                    if((mask >> function & 1u) != 0)
+                    {
+                        ++count;
+                        mask = 0;
+                    }
+                }
+                score += (1 << count) - 1;
+            }
+            bruteForce = std::max(bruteForce, score);
+        }
+        while(std::next_permutation(order.begin(), order.end()));
+
+        // Act
+        auto optimal = GetOptimalHitScore(hitMasks);
+        auto greedy = GetGreedyHitScore(hitMasks);
+
+        // Assert
+        ASSERT_EQ(bruteForce, optimal) << "game " << game;
+        ASSERT_LE(greedy, optimal) << "game " << game;
+        disagreements += greedy != optimal ? 1 : 0;
+    }
+
+    EXPECT_GT(disagreements, 0);
+}
+
+TEST(BackendTest, HitScoreShallScoreManyFunctionsGreedily)
+{
+    // Arrange
+    // 150 functions in three words per dot, each one hitting a dot of its own and function 149 also hitting the first 20 dots
+    const size_t wordsPerDot = 3;
+    std::vector<std::uint64_t> hitMasks(150 * wordsPerDot, 0);
+    for(size_t function = 0; function < 150; ++function)
+    {
+        hitMasks[function * wordsPerDot + function / 64] |= std::uint64_t(1) << (function % 64);
+    }
+    for(size_t dot = 0; dot < 20; ++dot)
+    {
+        hitMasks[dot * wordsPerDot + 149 / 64] |= std::uint64_t(1) << (149 % 64);
+    }
+
+    // Act
+    auto score = GetHitScore(hitMasks, wordsPerDot);
+    auto greedy = GetGreedyHitScore(hitMasks, wordsPerDot);
+
+    // Assert
+    EXPECT_EQ(greedy, score);
+    EXPECT_EQ((1 << 21) - 1 + 129, score);
+    EXPECT_ANY_THROW(GetOptimalHitScore(hitMasks, wordsPerDot));
+}
+
+TEST(BackendTest, HitScoreShallScoreFewFunctionsExactlyInAnyWord)
+{
+    // Arrange
+    // the board where greedy falls short, with the functions spread over two words per dot
+    std::vector<std::uint64_t> hitMasks{
+        1u, 1u,
+        0u, std::uint64_t(1) << 63,
+        0u, 1u,
+        1u, std::uint64_t(1) << 63
+    };
+
+    // Act
+    auto score = GetHitScore(hitMasks, 2);
+    auto greedy = GetGreedyHitScore(hitMasks, 2);
+
+    // Assert
+    EXPECT_EQ(3 + 3, score);
+    EXPECT_EQ(3 + 1 + 1, greedy);
+}
+
+#endif // TST_HITSCORE_H
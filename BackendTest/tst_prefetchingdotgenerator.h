@@ -0,0 +1,120 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_PREFETCHINGDOTGENERATOR_H
+#define TST_PREFETCHINGDOTGENERATOR_H
+
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/prefetchingdotgenerator.h"
+#include "../Backend/randomdotgenerator.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace testing;
+using namespace Backend;
+
+TEST(BackendTest, PrefetchingDotGeneratorShallKeepOrderOfBoards)
+{
+    // Arrange
+    PrefetchingDotGenerator generator(std::make_shared<FixedDotGenerator>(2), 2);
+
+    // Act
+    auto board1 = generator.Generate();
+    auto board2 = generator.Generate();
+    auto board3 = generator.Generate();
+
+    // Assert
+    ASSERT_EQ(5, board1.size());
+    ASSERT_EQ(5, board2.size());
+    ASSERT_EQ(5, board3.size());
+    EXPECT_EQ(std::make_pair(1.0, 1.0), board1[0]->GetCoordinates());
+    EXPECT_EQ(std::make_pair(-1.0, -1.0), board2[0]->GetCoordinates());
+    EXPECT_EQ(std::make_pair(1.0, 1.0), board3[0]->GetCoordinates());
+}
+
+TEST(BackendTest, PrefetchingDotGeneratorShallPrepareBoardsUpToDepth)
+{
+    // Arrange
+    PrefetchingDotGenerator generator(std::make_shared<RandomDotGenerator>(8, 2), 3);
+
+    // Act
+    auto readyBeforeFirst = generator.GetReadyCount();
+    auto board = generator.Generate();
+
+    for(int waited = 0; waited < 5000 && generator.GetReadyCount() < 3; waited += 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Assert
+    EXPECT_EQ(0, readyBeforeFirst);
+    EXPECT_EQ(10, board.size());
+    EXPECT_EQ(3, generator.GetDepth());
+    EXPECT_EQ(3, generator.GetReadyCount());
+}
+
+TEST(BackendTest, PrefetchingDotGeneratorWithoutDepthShallGenerateOnDemand)
+{
+    // Arrange
+    PrefetchingDotGenerator generator(std::make_shared<FixedDotGenerator>(2), 0);
+
+    // Act
+    auto board1 = generator.Generate();
+    auto board2 = generator.Generate();
+
+    // Assert
+    EXPECT_EQ(0, generator.GetReadyCount());
+    EXPECT_EQ(std::make_pair(1.0, 1.0), board1[0]->GetCoordinates());
+    EXPECT_EQ(std::make_pair(-1.0, -1.0), board2[0]->GetCoordinates());
+}
+
+TEST(BackendTest, PrefetchingDotGeneratorShallRethrowFailureAfterGeneratedBoards)
+{
+    // Arrange
+    PrefetchingDotGenerator generator(std::make_shared<FixedDotGenerator>(3), 2);
+
+    // Act
+    auto board1 = generator.Generate();
+    auto board2 = generator.Generate();
+
+    // Assert
+    EXPECT_EQ(std::make_pair(1.0, 1.0), board1[0]->GetCoordinates());
+    EXPECT_EQ(std::make_pair(-1.0, -1.0), board2[0]->GetCoordinates());
+    EXPECT_THROW(generator.Generate(), std::exception);
+}
+
+TEST(BackendTest, GameShallRemakeFromPrefetchedBoards)
+{
+    // Arrange
+    Game game(std::make_shared<PrefetchingDotGenerator>(std::make_shared<FixedDotGenerator>(2)), std::make_shared<MemoryRepository>());
+    auto firstDots = game.GetDots();
+
+    // Act
+    game.Remake();
+
+    // Assert
+    ASSERT_EQ(5, game.GetDots().size());
+    EXPECT_EQ(std::make_pair(1.0, 1.0), firstDots[0]->GetCoordinates());
+    EXPECT_EQ(std::make_pair(-1.0, -1.0), game.GetDots()[0]->GetCoordinates());
+}
+
+#endif // TST_PREFETCHINGDOTGENERATOR_H
@@ -0,0 +1,117 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_PROGRESSIVEEVALUATOR_H
+#define TST_PROGRESSIVEEVALUATOR_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/progressiveevaluator.h"
+#include "../Backend/game.h"
+#include "../Backend/basex.h"
+#include "../Backend/constant.h"
+#include "../Backend/product.h"
+#include "../Backend/functions.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, ProgressiveEvaluatorShallPublishPassesFromCoarseToFine)
+{
+    // Arrange
+    auto baseX = std::make_shared<BaseX>();
+    auto sine = std::make_shared<Sine>(baseX);
+
+    ProgressiveEvaluator evaluator(sine, -10.5, 10.5, 1000.0);
+
+    std::vector<std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>> snapshots;
+
+    // Act
+    auto graph = evaluator.Evaluate([&](auto snapshot){ snapshots.push_back(snapshot); });
+
+    // Assert
+    ASSERT_EQ(ProgressiveEvaluator::PassSampleCounts.size() + 1, snapshots.size());
+
+    for(size_t i = 0; i < ProgressiveEvaluator::PassSampleCounts.size(); ++i)
+    {
+        ASSERT_EQ(1, snapshots[i]->size());
+        EXPECT_EQ(ProgressiveEvaluator::PassSampleCounts[i], (*snapshots[i])[0].first.size());
+    }
+
+    EXPECT_EQ(graph, *(snapshots.back()));
+}
+
+TEST(BackendTest, ProgressiveEvaluatorShallSplitUniformPassesAtPoles)
+{
+    // Arrange
+    auto constant = std::make_shared<Constant>(1.0);
+    auto baseX = std::make_shared<BaseX>();
+    auto oneOverX = std::make_shared<Product>(std::vector<Product::Factor>{Product::Factor(Product::Exponent::Positive, constant), Product::Factor(Product::Exponent::Negative, baseX)});
+    auto tangent = std::make_shared<Tangent>(baseX);
+
+    ProgressiveEvaluator oneOverXEvaluator(oneOverX, -10.5, 10.5, 1000.0);
+    ProgressiveEvaluator tangentEvaluator(tangent, -10.5, 10.5, 9999.0);
+
+    // Act
+    auto oneOverXGraph = oneOverXEvaluator.EvaluateUniformly(64);
+    auto tangentGraph = tangentEvaluator.EvaluateUniformly(1024);
+
+    // Assert
+    ASSERT_EQ(2, oneOverXGraph.size());
+    EXPECT_LT(oneOverXGraph[0].first.back(), 0.0);
+    EXPECT_GT(oneOverXGraph[1].first.front(), 0.0);
+
+    EXPECT_EQ(7, tangentGraph.size());
+}
+
+TEST(BackendTest, GameShallPublishGraphSnapshotsForAllFunctions)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"1/x"),
+        std::wstring(L""),
+        std::wstring(L"x^2"),
+        std::wstring(L""),
+        std::wstring(L"")
+    };
+
+    std::vector<std::vector<std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>>> snapshots(5);
+
+    // Act
+    game.Update(exprStrings, nullptr, [&](unsigned long int index, auto snapshot){ snapshots[index].push_back(snapshot); });
+    auto graphs = game.GetGraphs();
+
+    game.Update(exprStrings, nullptr, [&](unsigned long int index, auto snapshot){ snapshots[index].push_back(snapshot); });
+
+    // Assert
+    EXPECT_EQ(ProgressiveEvaluator::PassSampleCounts.size() + 2, snapshots[0].size());
+    EXPECT_EQ(2, snapshots[1].size());
+    EXPECT_EQ(ProgressiveEvaluator::PassSampleCounts.size() + 2, snapshots[2].size());
+
+    EXPECT_EQ(graphs[0], *(snapshots[0].back()));
+    EXPECT_EQ(graphs[2], *(snapshots[2].back()));
+    EXPECT_TRUE(snapshots[1].back()->empty());
+}
+
+#endif // TST_PROGRESSIVEEVALUATOR_H
@@ -22,6 +22,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock-matchers.h>
 #include "../Backend/randomdotgenerator.h"
+#include <cmath>
+#include <set>
 
 using namespace testing;
 using namespace Backend;
@@ -47,4 +49,108 @@ TEST(BackendTest, RandomDotGeneratorShallCreateDotsInsideCertainRange)
     }
 }
 
+TEST(BackendTest, RandomDotGeneratorShallPlaceDotsOnLatticeOfBoard)
+{
+    // Arrange
+    BoardSpec boardSpec(900, 100, 50.5, 101, 1.0, 0.2, 0.4);
+    RandomDotGenerator generator(boardSpec);
+
+    // Act
+    auto dots = generator.Generate();
+
+    // Assert
+    ASSERT_EQ(1000, dots.size());
+
+    std::set<std::pair<long, long>> latticePoints;
+    size_t goodCount = 0;
+    for(const auto & dot : dots)
+    {
+        auto coordinates = dot->GetCoordinates();
+        EXPECT_LE(std::abs(coordinates.first), 50.15);
+        EXPECT_LE(std::abs(coordinates.second), 50.15);
+        EXPECT_GE(dot->GetRadius(), 0.2);
+        EXPECT_LE(dot->GetRadius(), 0.4);
+
+        latticePoints.insert(std::make_pair(std::lround(coordinates.first), std::lround(coordinates.second)));
+        goodCount += dot->IsGood() ? 1 : 0;
+    }
+
+    EXPECT_EQ(1000, latticePoints.size());
+    EXPECT_EQ(900, goodCount);
+}
+
+TEST(BackendTest, SeededRandomDotGeneratorShallRepeatBoards)
+{
+    // Arrange
+    RandomDotGenerator generator1(BoardSpec(), 12345);
+    RandomDotGenerator generator2(BoardSpec(), 12345);
+    RandomDotGenerator generator3(BoardSpec(), 54321);
+
+    // Act
+    std::vector<std::vector<std::shared_ptr<Dot>>> boards1;
+    std::vector<std::vector<std::shared_ptr<Dot>>> boards2;
+    for(int i = 0; i < 10; ++i)
+    {
+        boards1.push_back(generator1.Generate());
+        boards2.push_back(generator2.Generate());
+    }
+
+    auto otherBoard = generator3.Generate();
+
+    // Assert
+    for(size_t board = 0; board < boards1.size(); ++board)
+    {
+        ASSERT_EQ(10, boards1[board].size());
+        ASSERT_EQ(10, boards2[board].size());
+
+        for(size_t dot = 0; dot < boards1[board].size(); ++dot)
+        {
+            EXPECT_EQ(boards1[board][dot]->GetCoordinates(), boards2[board][dot]->GetCoordinates());
+            EXPECT_EQ(boards1[board][dot]->IsGood(), boards2[board][dot]->IsGood());
+        }
+    }
+
+    EXPECT_NE(boards1[0][0]->GetCoordinates(), boards1[1][0]->GetCoordinates());
+    EXPECT_NE(boards1[0][0]->GetCoordinates(), otherBoard[0]->GetCoordinates());
+}
+
+TEST(BackendTest, SeededRandomDotGeneratorShallCreateKnownBoard)
+{
+    // Arrange
+    RandomDotGenerator generator(BoardSpec(), 2021);
+
+    // Act
+    auto dots = generator.Generate();
+
+    // Assert
+    ASSERT_EQ(10, dots.size());
+    EXPECT_DOUBLE_EQ(-4.9384096829859532, dots[0]->GetCoordinates().first);
+    EXPECT_DOUBLE_EQ(7.9460394826997236, dots[0]->GetCoordinates().second);
+    EXPECT_DOUBLE_EQ(6.9024294282776442, dots[8]->GetCoordinates().first);
+    EXPECT_DOUBLE_EQ(0.063098533592624295, dots[8]->GetCoordinates().second);
+    EXPECT_FALSE(dots[8]->IsGood());
+}
+
+TEST(BackendTest, RandomDotGeneratorShallUseEachPositionOnceOnFullBoard)
+{
+    // Arrange
+    RandomDotGenerator generator(BoardSpec(300, 61), 99);
+
+    // Act
+    auto dots1 = generator.Generate();
+    auto dots2 = generator.Generate();
+
+    // Assert
+    for(const auto & dots : { dots1, dots2 })
+    {
+        std::set<std::pair<long, long>> latticePoints;
+        for(const auto & dot : dots)
+        {
+            latticePoints.insert(std::make_pair(std::lround(dot->GetCoordinates().first), std::lround(dot->GetCoordinates().second)));
+        }
+
+        EXPECT_EQ(361, latticePoints.size());
+    }
+}
+
 #endif // TST_RANDOMDOTGENERATOR_H
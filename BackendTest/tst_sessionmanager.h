@@ -0,0 +1,221 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_SESSIONMANAGER_H
+#define TST_SESSIONMANAGER_H
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/sessionmanager.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+#include "../TestHelper/localsessionclient.h"
+#include <map>
+#include <mutex>
+
+using namespace testing;
+using namespace Backend;
+
+TEST(BackendTest, SessionManagerShallServeGameRequests)
+{
+    // Arrange
+    SessionManager manager(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 2);
+    LocalSessionClient client(manager);
+
+    // Act
+    auto created = client.Send(L"{\"id\":1,\"command\":\"create\",\"session\":\"alice\"}");
+    auto updated = client.Send(L"{\"id\":2,\"command\":\"update\",\"session\":\"alice\",\"functions\":[\"1/x\",\"(x-3.0)*(x+4.0)\"]}");
+    auto scored = client.Send(L"{\"id\":3,\"command\":\"score\",\"session\":\"alice\"}");
+    auto saved = client.Send(L"{\"id\":4,\"command\":\"save\",\"session\":\"alice\",\"file\":\"alice.qpn\"}");
+    auto scoredOnly = client.Send(L"{\"id\":5,\"command\":\"score\",\"session\":\"alice\",\"functions\":[\"1/x\"]}");
+    auto loaded = client.Send(L"{\"id\":6,\"command\":\"load\",\"session\":\"alice\",\"file\":\"alice.qpn\"}");
+    auto closed = client.Send(L"{\"id\":7,\"command\":\"close\",\"session\":\"alice\"}");
+    auto afterClose = client.Send(L"{\"id\":8,\"command\":\"score\",\"session\":\"alice\"}");
+
+    // Assert
+    ASSERT_TRUE(created.IsObject());
+    EXPECT_EQ(1, created[L"id"].GetInt());
+    EXPECT_TRUE(created[L"ok"].GetBool());
+    EXPECT_EQ(0, created[L"score"].GetInt());
+    ASSERT_EQ(5, created[L"dots"].Size());
+    EXPECT_DOUBLE_EQ(-8.0, created[L"dots"][1][L"x"].GetDouble());
+    EXPECT_TRUE(created[L"dots"][0][L"good"].GetBool());
+    EXPECT_FALSE(created[L"dots"][4][L"good"].GetBool());
+
+    EXPECT_TRUE(updated[L"ok"].GetBool());
+    EXPECT_EQ(3 + 1, updated[L"score"].GetInt());
+    EXPECT_TRUE(updated[L"dots"][2][L"hit"].GetBool());
+    EXPECT_FALSE(updated[L"dots"][3][L"hit"].GetBool());
+
+    EXPECT_EQ(3 + 1, scored[L"score"].GetInt());
+    EXPECT_TRUE(saved[L"ok"].GetBool());
+    EXPECT_EQ(3, scoredOnly[L"score"].GetInt());
+
+    EXPECT_TRUE(loaded[L"ok"].GetBool());
+    EXPECT_EQ(3 + 1, loaded[L"score"].GetInt());
+    ASSERT_EQ(5, loaded[L"functions"].Size());
+    EXPECT_EQ(std::wstring(L"1/x"), std::wstring(loaded[L"functions"][0].GetString()));
+
+    EXPECT_TRUE(closed[L"ok"].GetBool());
+    EXPECT_EQ(8, afterClose[L"id"].GetInt());
+    EXPECT_FALSE(afterClose[L"ok"].GetBool());
+    EXPECT_EQ(0, manager.GetSessionCount());
+    EXPECT_EQ(7, manager.GetCompletedCount());
+}
+
+TEST(BackendTest, SessionManagerShallRejectMalformedRequests)
+{
+    // Arrange
+    SessionManager manager(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1);
+    LocalSessionClient client(manager);
+    client.Send(L"{\"command\":\"create\",\"session\":\"bob\"}");
+
+    // Act
+    auto notJson = client.Send(L"{\"command\":");
+    auto noCommand = client.Send(L"{\"id\":\"a\",\"session\":\"bob\"}");
+    auto unknownCommand = client.Send(L"{\"id\":\"b\",\"command\":\"cheat\",\"session\":\"bob\"}");
+    auto noSession = client.Send(L"{\"id\":\"c\",\"command\":\"update\",\"functions\":[]}");
+    auto unknownSession = client.Send(L"{\"id\":\"d\",\"command\":\"update\",\"session\":\"carol\",\"functions\":[]}");
+    auto duplicate = client.Send(L"{\"id\":\"e\",\"command\":\"create\",\"session\":\"bob\"}");
+    auto noFunctions = client.Send(L"{\"id\":\"f\",\"command\":\"update\",\"session\":\"bob\"}");
+    auto badFunctions = client.Send(L"{\"id\":\"g\",\"command\":\"update\",\"session\":\"bob\",\"functions\":[1]}");
+    auto noFile = client.Send(L"{\"id\":\"h\",\"command\":\"load\",\"session\":\"bob\"}");
+    auto missingFile = client.Send(L"{\"id\":\"i\",\"command\":\"load\",\"session\":\"bob\",\"file\":\"missing.qpn\"}");
+
+    // Assert
+    std::vector<rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> *> rejected =
+    {
+        &notJson, &noCommand, &unknownCommand, &noSession, &unknownSession, &duplicate, &noFunctions, &badFunctions, &noFile, &missingFile
+    };
+
+    for(auto response : rejected)
+    {
+        ASSERT_TRUE(response->IsObject());
+        EXPECT_FALSE((*response)[L"ok"].GetBool());
+        EXPECT_TRUE((*response)[L"error"].IsString());
+    }
+
+    EXPECT_FALSE(notJson.HasMember(L"id"));
+    EXPECT_EQ(std::wstring(L"a"), std::wstring(noCommand[L"id"].GetString()));
+    EXPECT_EQ(std::wstring(L"i"), std::wstring(missingFile[L"id"].GetString()));
+    EXPECT_EQ(1, manager.GetSessionCount());
+    EXPECT_EQ(2, manager.GetCompletedCount());
+}
+
+TEST(BackendTest, SessionManagerShallRejectFilesOutsideSaveDirectory)
+{
+    // Arrange
+    SessionManager manager(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1);
+    LocalSessionClient client(manager);
+    client.Send(L"{\"command\":\"create\",\"session\":\"bob\"}");
+
+    std::vector<std::wstring> files =
+    {
+        L"", L".", L"..", L"../bob.qpn", L"..\\\\bob.qpn", L"saves/bob.qpn", L"/tmp/bob.qpn", L"C:bob.qpn", L".hidden"
+    };
+
+    for(const auto & file : files)
+    {
+        // Act
+        auto saved = client.Send(L"{\"command\":\"save\",\"session\":\"bob\",\"file\":\"" + file + L"\"}");
+        auto loaded = client.Send(L"{\"command\":\"load\",\"session\":\"bob\",\"file\":\"" + file + L"\"}");
+
+        // Assert
+        ASSERT_TRUE(saved.IsObject());
+        EXPECT_FALSE(saved[L"ok"].GetBool());
+        ASSERT_TRUE(loaded.IsObject());
+        EXPECT_FALSE(loaded[L"ok"].GetBool());
+    }
+
+    auto plain = client.Send(L"{\"command\":\"save\",\"session\":\"bob\",\"file\":\"bob-1_final.qpn\"}");
+    EXPECT_TRUE(plain[L"ok"].GetBool());
+    EXPECT_EQ(2, manager.GetCompletedCount());
+}
+
+TEST(BackendTest, SessionManagerShallKeepOrderPerSession)
+{
+    // Arrange
+    SessionManager manager(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 4);
+
+    const int sessionCount = 8;
+    const int updateCount = 6;
+    std::mutex mutex;
+    std::map<std::wstring, std::vector<int>> idsBySession;
+    std::map<std::wstring, int> lastScoreBySession;
+
+    auto submit = [&](const std::wstring & session, int id, const std::wstring & rest)
+    {
+        manager.Submit(std::wstring(L"{\"id\":") + std::to_wstring(id) + L",\"session\":\"" + session + L"\"," + rest + L"}", [&, session](const std::wstring & responseLine)
+        {
+            rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> response;
+            response.Parse(responseLine.c_str());
+
+            std::lock_guard<std::mutex> lock(mutex);
+            idsBySession[session].push_back(response[L"id"].GetInt());
+            if(response.HasMember(L"score"))
+            {
+                lastScoreBySession[session] = response[L"score"].GetInt();
+            }
+        });
+    };
+
+    // Act
+    for(int s = 0; s < sessionCount; ++s)
+    {
+        submit(std::wstring(L"s") + std::to_wstring(s), 0, L"\"command\":\"create\"");
+    }
+
+    for(int u = 1; u <= updateCount; ++u)
+    {
+        for(int s = 0; s < sessionCount; ++s)
+        {
+            // sessions end up on different functions, the last update being odd for odd sessions
+            bool isFull = (u + s) % 2 == 0;
+            submit(std::wstring(L"s") + std::to_wstring(s), u, isFull ? L"\"command\":\"update\",\"functions\":[\"1/x\",\"(x-3.0)*(x+4.0)\"]" : L"\"command\":\"update\",\"functions\":[\"1/x\"]");
+        }
+    }
+
+    manager.WaitUntilIdle();
+
+    LocalSessionClient client(manager);
+    auto stats = client.Send(L"{\"command\":\"stats\"}");
+
+    // Assert
+    ASSERT_EQ(sessionCount, idsBySession.size());
+    for(int s = 0; s < sessionCount; ++s)
+    {
+        auto session = std::wstring(L"s") + std::to_wstring(s);
+        std::vector<int> expectedIds;
+        for(int u = 0; u <= updateCount; ++u)
+        {
+            expectedIds.push_back(u);
+        }
+
+        EXPECT_EQ(expectedIds, idsBySession[session]);
+        EXPECT_EQ((updateCount + s) % 2 == 0 ? 3 + 1 : 3, lastScoreBySession[session]);
+    }
+
+    EXPECT_EQ(4, manager.GetWorkerCount());
+    EXPECT_EQ(sessionCount, stats[L"sessions"].GetInt());
+    EXPECT_EQ(sessionCount * (updateCount + 1), stats[L"completed"].GetInt());
+    EXPECT_GT(stats[L"p50"].GetDouble(), 0.0);
+    EXPECT_LE(stats[L"p50"].GetDouble(), stats[L"p90"].GetDouble());
+    EXPECT_LE(stats[L"p90"].GetDouble(), stats[L"p99"].GetDouble());
+}
+
+#endif // TST_SESSIONMANAGER_H
@@ -0,0 +1,121 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_THREADPOOL_H
+#define TST_THREADPOOL_H
+
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/threadpool.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+TEST(BackendTest, ThreadPoolShallRunEachTaskExactlyOnce)
+{
+    // Arrange
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> runs(1000);
+
+    // Act
+    pool.ForEach(runs.size(), [&](size_t index){ ++runs[index]; });
+    pool.ForEach(runs.size(), [&](size_t index){ ++runs[index]; });
+    pool.ForEach(0, [&](size_t){ FAIL(); });
+
+    // Assert
+    EXPECT_EQ(4u, pool.GetThreadCount());
+    for(size_t i = 0; i < runs.size(); ++i)
+    {
+        EXPECT_EQ(2, runs[i]) << "task " << i;
+    }
+}
+
+TEST(BackendTest, ThreadPoolShallRethrowAfterAllTasksFinished)
+{
+    // Arrange
+    ThreadPool pool(3);
+    std::atomic<int> runs(0);
+
+    // Act
+    auto run = [&]()
+    {
+        pool.ForEach(100, [&](size_t index)
+        {
+            ++runs;
+            if(index == 7)
+            {
+                throw std::exception("task failed");
+            }
+        });
+    };
+
+    // Assert
+    EXPECT_ANY_THROW(run());
+    EXPECT_EQ(100, runs);
+}
+
+TEST(BackendTest, GameShallCheckDotsInParallelLikeSequentially)
+{
+    // Arrange
+    std::vector<std::shared_ptr<Dot>> dots;
+    for(int i = 0; i < 60; ++i)
+    {
+        dots.emplace_back(std::make_shared<Dot>(-10.0 + (i % 20), -3.0 + 3.0 * (i / 20) + 0.1 * (i % 7), i % 9 != 0));
+    }
+
+    std::vector<std::shared_ptr<Dot>> parallelDots;
+    for(auto & dot : dots)
+    {
+        parallelDots.emplace_back(std::make_shared<Dot>(dot->GetCoordinates().first, dot->GetCoordinates().second, dot->IsGood()));
+    }
+
+    Game sequentialGame(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 1);
+    Game parallelGame(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>(), 4);
+    sequentialGame.SetDots(dots);
+    parallelGame.SetDots(parallelDots);
+
+    std::vector<std::wstring> exprStrings =
+    {
+        std::wstring(L"sin(x)*3"),
+        std::wstring(L"1/x"),
+        std::wstring(L"0.1*x^2-3"),
+        std::wstring(L"x"),
+        std::wstring(L"tan(x)")
+    };
+
+    // Act
+    sequentialGame.Update(exprStrings);
+    parallelGame.Update(exprStrings);
+
+    // Assert
+    for(size_t i = 0; i < dots.size(); ++i)
+    {
+        EXPECT_EQ(dots[i]->IsActive(), parallelDots[i]->IsActive()) << "dot " << i;
+    }
+    EXPECT_TRUE(std::any_of(dots.begin(), dots.end(), [](auto dot){ return dot->IsActive(); }));
+    EXPECT_EQ(sequentialGame.GetScore(), parallelGame.GetScore());
+}
+
+#endif // TST_THREADPOOL_H
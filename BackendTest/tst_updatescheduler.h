@@ -0,0 +1,180 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_UPDATESCHEDULER_H
+#define TST_UPDATESCHEDULER_H
+
+#include <memory>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+#include "../Backend/updatescheduler.h"
+#include "../Backend/game.h"
+#include "../TestHelper/fixeddotgenerator.h"
+#include "../TestHelper/memoryrepository.h"
+
+using namespace Backend;
+using namespace testing;
+
+namespace
+{
+    // holds the first update at its first progress report until released
+    class UpdateBlocker
+    {
+    private:
+        std::promise<void> started;
+        std::promise<void> release;
+        std::shared_future<void> released;
+        std::atomic<bool> isFirst;
+
+    public:
+        UpdateBlocker()
+            : released(release.get_future().share()),
+              isFirst(true)
+        {
+        }
+
+        std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> GetProgress()
+        {
+            return [this](unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)
+            {
+                if(this->isFirst.exchange(false))
+                {
+                    this->started.set_value();
+                    this->released.wait();
+                }
+            };
+        }
+
+        void WaitUntilStarted()
+        {
+            this->started.get_future().wait();
+        }
+
+        void Release()
+        {
+            this->release.set_value();
+        }
+    };
+}
+
+TEST(BackendTest, UpdateSchedulerShallRunOnlyLatestRequest)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    UpdateScheduler scheduler(game);
+    UpdateBlocker blocker;
+
+    std::vector<std::wstring> first{ L"x", L"", L"", L"", L"" };
+    std::vector<std::wstring> second{ L"1/x", L"", L"", L"", L"" };
+    std::vector<std::wstring> third{ L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+    auto firstToken = std::make_shared<CancellationToken>();
+    auto secondToken = std::make_shared<CancellationToken>();
+    auto thirdToken = std::make_shared<CancellationToken>();
+
+    // Act
+    auto mustRun = scheduler.Submit(first, firstToken, blocker.GetProgress());
+    std::thread runner([&](){ scheduler.Run(); });
+    blocker.WaitUntilStarted();
+
+    auto mustRunSecond = scheduler.Submit(second, secondToken, blocker.GetProgress());
+    auto mustRunThird = scheduler.Submit(third, thirdToken, blocker.GetProgress());
+    blocker.Release();
+    runner.join();
+
+    // Assert
+    EXPECT_TRUE(mustRun);
+    EXPECT_FALSE(mustRunSecond);
+    EXPECT_FALSE(mustRunThird);
+    EXPECT_TRUE(firstToken->IsCancelled());
+    EXPECT_FALSE(secondToken->IsCancelled());
+    EXPECT_FALSE(thirdToken->IsCancelled());
+    EXPECT_EQ(third, game.GetFunctions());
+    EXPECT_EQ(3 + 1, game.GetScore());
+    EXPECT_EQ(3, scheduler.GetSubmittedCount());
+    EXPECT_EQ(1, scheduler.GetDroppedCount());
+    EXPECT_EQ(0, scheduler.GetCoalescedCount());
+    EXPECT_EQ(1, scheduler.GetCancelledCount());
+}
+
+TEST(BackendTest, UpdateSchedulerShallCoalesceIdenticalRequests)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    UpdateScheduler scheduler(game);
+    UpdateBlocker blocker;
+
+    std::vector<std::wstring> first{ L"1/x", L"(x-3.0)*(x+4.0)", L"", L"", L"" };
+    std::vector<std::wstring> second{ L"x", L"", L"", L"", L"" };
+    auto token = std::make_shared<CancellationToken>();
+
+    // Act
+    scheduler.Submit(first, token, blocker.GetProgress());
+    std::thread runner([&](){ scheduler.Run(); });
+    blocker.WaitUntilStarted();
+
+    auto mustRunRepeated = scheduler.Submit(first, std::make_shared<CancellationToken>());
+    blocker.Release();
+    runner.join();
+
+    auto mustRunAfterwards = scheduler.Submit(second, std::make_shared<CancellationToken>());
+    auto mustRunPendingRepeated = scheduler.Submit(second, std::make_shared<CancellationToken>());
+    scheduler.Run();
+
+    // Assert
+    EXPECT_FALSE(mustRunRepeated);
+    EXPECT_TRUE(mustRunAfterwards);
+    EXPECT_FALSE(mustRunPendingRepeated);
+    EXPECT_FALSE(token->IsCancelled());
+    EXPECT_EQ(second, game.GetFunctions());
+    EXPECT_EQ(4, scheduler.GetSubmittedCount());
+    EXPECT_EQ(0, scheduler.GetDroppedCount());
+    EXPECT_EQ(2, scheduler.GetCoalescedCount());
+    EXPECT_EQ(0, scheduler.GetCancelledCount());
+}
+
+TEST(BackendTest, UpdateSchedulerShallRecoverFromThrowingUpdate)
+{
+    // Arrange
+    Game game(std::make_shared<FixedDotGenerator>(), std::make_shared<MemoryRepository>());
+    UpdateScheduler scheduler(game);
+
+    std::vector<std::wstring> first{ L"1/x", L"", L"", L"", L"" };
+    std::vector<std::wstring> second{ L"x", L"", L"", L"", L"" };
+    auto throwing = [](unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)
+    {
+        throw std::exception("progress failed");
+    };
+
+    // Act
+    auto mustRun = scheduler.Submit(first, std::make_shared<CancellationToken>(), throwing);
+    EXPECT_ANY_THROW(scheduler.Run());
+
+    auto mustRunAfterwards = scheduler.Submit(second, std::make_shared<CancellationToken>());
+    scheduler.Run();
+
+    // Assert
+    EXPECT_TRUE(mustRun);
+    EXPECT_TRUE(mustRunAfterwards);
+    EXPECT_EQ(second, game.GetFunctions());
+    EXPECT_EQ(2, scheduler.GetSubmittedCount());
+}
+
+#endif // TST_UPDATESCHEDULER_H
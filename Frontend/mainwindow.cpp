@@ -20,11 +20,14 @@
 #include <QStandardPaths>
 
 #include "mainwindow.h"
+#include "../Backend/graphdecimator.h"
 
+#include <algorithm>
 #include <vector>
 #include <sstream>
 #include <iterator>
 #include <functional>
+#include <cmath>
 
 MainWindow::MainWindow(std::shared_ptr<Backend::DotGenerator> dotGenerator,
                        std::shared_ptr<Backend::Repository> repository,
@@ -32,6 +35,7 @@ MainWindow::MainWindow(std::shared_ptr<Backend::DotGenerator> dotGenerator,
     : MainWindow(parent)
 {
     this->game = Backend::Game(dotGenerator, repository);
+    this->InitializePlot();
 }
 
 MainWindow::MainWindow(std::shared_ptr<Backend::DotGenerator> dotGenerator,
@@ -39,13 +43,17 @@ MainWindow::MainWindow(std::shared_ptr<Backend::DotGenerator> dotGenerator,
     : MainWindow(parent)
 {
     this->game = Backend::Game(dotGenerator);
+    this->InitializePlot();
 }
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , game()
+    , gameUpdateScheduler(game)
     , focusIndicator(-2)
+    , arePreviewGraphsShown(false)
+    , decimationColumnCount(0)
 {
     ui->setupUi(this);
     this->UpdateWindowTitle();
@@ -56,6 +64,7 @@ MainWindow::MainWindow(QWidget *parent)
     this->waitTimer.setInterval(500);
 
     this->SetupColors();
+    this->SetupUnitCircle();
 
     this->InitializePlot();
 
@@ -70,6 +79,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     connect(&gameUpdateFutureWatcher, &QFutureWatcher<void>::finished, this, &MainWindow::OnGameUpdateFinished);
     connect(&waitTimer, &QTimer::timeout, this, &MainWindow::OnWaitTimerFinished);
+    connect(ui->plot, &QCustomPlot::afterLayout, this, &MainWindow::OnPlotLayoutUpdated);
     connect(ui->newGameMenuAction, &QAction::triggered, this, &MainWindow::OnNewGameMenuTriggered);
     connect(ui->openGameMenuAction, &QAction::triggered, this, &MainWindow::OnOpenGameMenuTriggered);
     connect(ui->saveGameMenuAction, &QAction::triggered, this, &MainWindow::OnSaveGameMenuTriggered);
@@ -116,8 +126,12 @@ void MainWindow::OnOpenGameMenuTriggered()
         this->SetGameIsBusy(true);
         this->SetFunctionsInputFromGame();
 
+        auto cancellationToken = std::make_shared<Backend::CancellationToken>();
+        this->gameUpdateCancellationToken = cancellationToken;
+        auto progress = this->CreateProgressHandler(cancellationToken);
+
         QFuture<void> updateFuture = QtConcurrent::run([=](){
-            this->game.CreateGraphs();
+            this->game.CreateGraphs(cancellationToken, progress);
         });
         this->gameUpdateFutureWatcher.setFuture(updateFuture);
 
@@ -207,12 +221,18 @@ void MainWindow::InitializePlot()
 {
     ui->plot->xAxis->setLabel("x");
     ui->plot->yAxis->setLabel("y");
-    ui->plot->xAxis->setRange(-10, 10);
-    ui->plot->yAxis->setRange(-10, 10);
+
+    // the axes end on the last whole unit inside the window
+    auto axisEnd = std::floor(this->game.GetBoardSpec().GetExtent());
+    ui->plot->xAxis->setRange(-axisEnd, axisEnd);
+    ui->plot->yAxis->setRange(-axisEnd, axisEnd);
 
     ui->plot->clearPlottables();
+    this->graphPlottables.clear();
 
-    this->DrawDots();
+    auto snapshot = this->game.GetSnapshot();
+    this->DrawDots(*snapshot);
+    this->drawnSnapshot.reset();
 
     ui->plot->replot();
 }
@@ -238,7 +258,22 @@ void MainWindow::SetupColors()
     this->nonParseablePalette.setColor(QPalette::Text, Qt::black);
 }
 
-void MainWindow::DrawDots()
+void MainWindow::SetupUnitCircle()
+{
+    // create data for generic circular curve
+    const int pointCount = 500;
+    this->unitCircleX.resize(pointCount);
+    this->unitCircleY.resize(pointCount);
+
+    for (int i=0; i<pointCount; ++i)
+    {
+        double theta = i/(double)(pointCount-1)*2*M_PI;
+        this->unitCircleX[i] = qCos(theta);
+        this->unitCircleY[i] = qSin(theta);
+    }
+}
+
+void MainWindow::DrawDots(const Backend::GameSnapshot & snapshot)
 {
     // clear existing curves for dots
     auto dotCurvesIterator = this->dotCurves.begin();
@@ -252,7 +287,7 @@ void MainWindow::DrawDots()
     this->dotCurves.clear();
 
     // get dots and get ready to iterate
-    auto dots = this->game.GetDots();
+    auto & dots = snapshot.GetDots();
 
     auto dotsIterator = dots.begin();
     auto dotsEnd = dots.end();
@@ -262,30 +297,9 @@ void MainWindow::DrawDots()
         return;
     }
 
-    // create data for generic circular curve
-    const int pointCount = 500;
-    QVector<double> dataX(pointCount);
-    QVector<double> dataY(pointCount);
-
-    for (int i=0; i<pointCount; ++i)
-    {
-        double theta = i/(double)(pointCount-1)*2*M_PI;
-        dataX[i] = qCos(theta);
-        dataY[i] = qSin(theta);
-    }
-
-    std::function<QColor(bool, bool)> determineDotColor = [&](bool isActive, bool isGood)
-    {
-        if(isActive)
-        {
-            return isGood ? this->activeGoodDotColor : this->activeBadDotColor;
-
-        }
-        else
-        {
-            return isGood ? this->inactiveGoodDotColor : this->inactiveBadDotColor;
-        }
-    };
+    const int pointCount = this->unitCircleX.size();
+    auto & dataX = this->unitCircleX;
+    auto & dataY = this->unitCircleY;
 
     while(dotsIterator != dotsEnd)
     {
@@ -306,7 +320,7 @@ void MainWindow::DrawDots()
 
         // apply color according to dot characteristics
         curve->data()->set(dataCurve, true);
-        auto dotColor = determineDotColor((*dotsIterator)->IsActive(), (*dotsIterator)->IsGood());
+        auto dotColor = this->GetDotColor((*dotsIterator)->IsActive(), (*dotsIterator)->IsGood());
         curve->setBrush(QBrush(dotColor));
         curve->setPen(QPen(dotColor));
 
@@ -314,35 +328,165 @@ void MainWindow::DrawDots()
     }
 }
 
-void MainWindow::DrawGraphs()
+QColor MainWindow::GetDotColor(bool isActive, bool isGood) const
+{
+    if(isActive)
+    {
+        return isGood ? this->activeGoodDotColor : this->activeBadDotColor;
+
+    }
+    else
+    {
+        return isGood ? this->inactiveGoodDotColor : this->inactiveBadDotColor;
+    }
+}
+
+void MainWindow::RecolorDots(const Backend::GameSnapshot & snapshot, const std::vector<size_t> & dotIndices)
 {
-    auto& graphs = this->game.GetGraphs();
+    auto & dots = snapshot.GetDots();
+
+    for(auto dotIndex : dotIndices)
+    {
+        if(dotIndex >= this->dotCurves.size() || dotIndex >= dots.size())
+        {
+            continue;
+        }
 
+        auto dotColor = this->GetDotColor(dots[dotIndex]->IsActive(), dots[dotIndex]->IsGood());
+        this->dotCurves[dotIndex]->setBrush(QBrush(dotColor));
+        this->dotCurves[dotIndex]->setPen(QPen(dotColor));
+    }
+}
+
+void MainWindow::DrawGraphs(const Backend::GameSnapshot & snapshot)
+{
     ui->plot->clearGraphs();
+    this->graphPlottables.clear();
+    this->arePreviewGraphsShown = false;
+
+    for(size_t graphIndex = 0; graphIndex < snapshot.GetGraphCount(); ++graphIndex)
+    {
+        this->DrawGraph(graphIndex, snapshot.GetGraph(graphIndex));
+    }
+}
 
-    for(unsigned long long graphIndex = 0; graphIndex < graphs.size(); ++graphIndex)
+void MainWindow::DrawGraph(size_t graphIndex, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph)
+{
+    auto pen = QPen(graphColors[graphIndex]);
+
+    // there is no use in handing more points to the plot than it has pixel columns to show them
+    auto range = ui->plot->xAxis->range();
+    this->decimationColumnCount = std::max(1, ui->plot->axisRect()->width());
+    Backend::GraphDecimator decimator(range.lower, range.upper, static_cast<unsigned int>(this->decimationColumnCount));
+    auto decimatedGraph = decimator.Decimate(graph);
+
+    if(this->graphPlottables.size() <= graphIndex)
     {
-        auto& graph = graphs[graphIndex];
-        auto pen = QPen(graphColors[graphIndex]);
+        this->graphPlottables.resize(graphIndex + 1);
+    }
 
-        for(unsigned long long branchIndex = 0; branchIndex < graph.size(); ++branchIndex)
+    for(unsigned long long branchIndex = 0; branchIndex < decimatedGraph.size(); ++branchIndex)
+    {
+        auto& branch = decimatedGraph[branchIndex];
+
+        if(branch.first.empty())
         {
-            auto& branch = graph[branchIndex];
+            continue;
+        }
 
-            if(branch.first.empty())
-            {
-                continue;
-            }
+        QVector<double> dataX(branch.first.begin(), branch.first.end());
+        QVector<double> dataY(branch.second.begin(), branch.second.end());
+
+        auto* qcpGraph = ui->plot->addGraph();
+
+        qcpGraph->addData(dataX, dataY, true);
+        qcpGraph->setPen(pen);
+        this->graphPlottables[graphIndex].push_back(qcpGraph);
+    }
+}
+
+void MainWindow::OnPlotLayoutUpdated()
+{
+    // the graphs were decimated for the former width, so they are decimated again from the full graphs
+    if(this->graphPlottables.empty() || std::max(1, ui->plot->axisRect()->width()) == this->decimationColumnCount)
+    {
+        return;
+    }
 
-            QVector<double> dataX(branch.first.begin(), branch.first.end());
-            QVector<double> dataY(branch.second.begin(), branch.second.end());
+    // the replot in progress draws the new plottables, as it lays out before it draws
+    if(this->arePreviewGraphsShown)
+    {
+        this->DrawPreviewGraphs();
+    }
+    else if(this->drawnSnapshot)
+    {
+        this->DrawGraphs(*this->drawnSnapshot);
+    }
+}
+
+void MainWindow::RedrawGraph(const Backend::GameSnapshot & snapshot, size_t graphIndex)
+{
+    if(graphIndex < this->graphPlottables.size())
+    {
+        for(auto * qcpGraph : this->graphPlottables[graphIndex])
+        {
+            ui->plot->removeGraph(qcpGraph);
+        }
+
+        this->graphPlottables[graphIndex].clear();
+    }
+
+    if(graphIndex < snapshot.GetGraphCount())
+    {
+        this->DrawGraph(graphIndex, snapshot.GetGraph(graphIndex));
+    }
+}
 
-            auto* qcpGraph = ui->plot->addGraph();
+void MainWindow::DrawPreviewGraphs()
+{
+    ui->plot->clearGraphs();
+    this->graphPlottables.clear();
+    this->arePreviewGraphsShown = true;
 
-            qcpGraph->addData(dataX, dataY, true);
-            qcpGraph->setPen(pen);
+    for(size_t graphIndex = 0; graphIndex < this->previewGraphs.size(); ++graphIndex)
+    {
+        if(this->previewGraphs[graphIndex])
+        {
+            this->DrawGraph(graphIndex, *(this->previewGraphs[graphIndex]));
         }
     }
+
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnGraphSnapshotPublished(std::shared_ptr<Backend::CancellationToken> cancellationToken,
+                                          unsigned long int graphIndex,
+                                          std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> snapshot)
+{
+    // snapshots of a calculation that is no longer current must not be drawn
+    if(cancellationToken != this->gameUpdateCancellationToken || cancellationToken->IsCancelled())
+    {
+        return;
+    }
+
+    if(this->previewGraphs.size() <= graphIndex)
+    {
+        this->previewGraphs.resize(graphIndex + 1);
+    }
+
+    this->previewGraphs[graphIndex] = snapshot;
+    this->DrawPreviewGraphs();
+}
+
+std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> MainWindow::CreateProgressHandler(std::shared_ptr<Backend::CancellationToken> cancellationToken)
+{
+    this->previewGraphs.clear();
+
+    // called on the worker thread, drawing happens on the UI thread
+    return [=](unsigned long int graphIndex, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> snapshot)
+    {
+        QMetaObject::invokeMethod(this, [=](){ this->OnGraphSnapshotPublished(cancellationToken, graphIndex, snapshot); }, Qt::QueuedConnection);
+    };
 }
 
 void MainWindow::UpdateWindowTitle()
@@ -350,7 +494,7 @@ void MainWindow::UpdateWindowTitle()
     //: Arg 1 is the window title, Arg 2 is the numerical score
     auto windowTitleTemplate = QCoreApplication::translate("MainWindow", "%1 - Score: %2", nullptr).arg(QCoreApplication::translate("MainWindow", "QtPollyNom", nullptr));
 
-    auto score = this->game.GetScore();
+    auto score = this->game.GetSnapshot()->GetScore();
 
     QString newTitle;
 
@@ -412,8 +556,41 @@ void MainWindow::UpdateGui()
 {
     this->SetGameIsBusy(false);
 
-    this->DrawDots();
-    this->DrawGraphs();
+    auto snapshot = this->game.GetSnapshot();
+
+    // only what changed since the last drawing is drawn again
+    if(!this->drawnSnapshot)
+    {
+        this->DrawDots(*snapshot);
+        this->DrawGraphs(*snapshot);
+    }
+    else
+    {
+        auto changes = snapshot->GetChangesSince(*this->drawnSnapshot);
+
+        if(changes.areDotsReplaced)
+        {
+            this->DrawDots(*snapshot);
+        }
+        else
+        {
+            this->RecolorDots(*snapshot, changes.changedDots);
+        }
+
+        if(this->arePreviewGraphsShown)
+        {
+            this->DrawGraphs(*snapshot);
+        }
+        else
+        {
+            for(auto graphIndex : changes.changedGraphs)
+            {
+                this->RedrawGraph(*snapshot, graphIndex);
+            }
+        }
+    }
+
+    this->drawnSnapshot = snapshot;
     this->UpdateWindowTitle();
 
     ui->plot->replot();
@@ -421,7 +598,7 @@ void MainWindow::UpdateGui()
 
 void MainWindow::SetFunctionsInputFromGame()
 {
-    std::vector<std::wstring> funcStrings = this->game.GetFunctions();
+    std::vector<std::wstring> funcStrings = this->game.GetSnapshot()->GetFunctions();
 
     for(size_t i = 0; i<this->numberOfFunctionInputs && i<funcStrings.size(); ++i)
     {
@@ -440,10 +617,18 @@ void MainWindow::StartCalculation()
         funcStrings.emplace_back(this->ui->funcLineEdit[i]->text().toStdWString());
     }
 
-    QFuture<void> updateFuture = QtConcurrent::run([=](){
-        this->game.Update(funcStrings);
-    });
-    this->gameUpdateFutureWatcher.setFuture(updateFuture);
+    auto cancellationToken = std::make_shared<Backend::CancellationToken>();
+    this->gameUpdateCancellationToken = cancellationToken;
+    auto progress = this->CreateProgressHandler(cancellationToken);
+
+    // a calculation already running picks up the new functions itself
+    if(this->gameUpdateScheduler.Submit(funcStrings, cancellationToken, progress))
+    {
+        QFuture<void> updateFuture = QtConcurrent::run([=](){
+            this->gameUpdateScheduler.Run();
+        });
+        this->gameUpdateFutureWatcher.setFuture(updateFuture);
+    }
 
     this->waitTimer.start();
 }
@@ -491,6 +676,8 @@ void MainWindow::OnFuncLineEditTextChanged()
 void MainWindow::OnGameUpdateFinished()
 {
     this->waitTimer.stop();
+    this->gameUpdateCancellationToken.reset();
+    this->previewGraphs.clear();
     if(this->waitingMessageBox)
     {
         this->waitingMessageBox->close();
@@ -524,7 +711,15 @@ void MainWindow::OnWaitTimerFinished()
 
 void MainWindow::OnWaitingMessageBoxButtonClicked()
 {
+    this->gameUpdateScheduler.CancelAll();
+    if(this->gameUpdateCancellationToken)
+    {
+        this->gameUpdateCancellationToken->Cancel();
+    }
+
+    // the worker returns promptly after cancellation and must not touch the game while it is cleared
     this->gameUpdateFutureWatcher.cancel();
+    this->gameUpdateFutureWatcher.waitForFinished();
     this->game.Clear();
     this->UpdateGui();
 }
@@ -36,6 +36,7 @@
 #include <vector>
 #include "qcustomplot.h"
 #include "../Backend/game.h"
+#include "../Backend/updatescheduler.h"
 #include "../Backend/dotgenerator.h"
 
 QT_BEGIN_NAMESPACE
@@ -272,6 +273,7 @@ class MainWindow : public QMainWindow
 private:
     Ui::MainWindow *ui;
     Backend::Game game;
+    Backend::UpdateScheduler gameUpdateScheduler;
 
     /*!
      * \brief focusIndicator indicates the focus before a calculation
@@ -282,6 +284,28 @@ private:
     int focusIndicator;
 
     QFutureWatcher<void> gameUpdateFutureWatcher;
+    std::shared_ptr<Backend::CancellationToken> gameUpdateCancellationToken;
+
+    /*!
+     * \brief previewGraphs holds the latest snapshot per function published during a running calculation.
+     */
+    std::vector<std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>> previewGraphs;
+
+    /*!
+     * \brief drawnSnapshot is the state of the game currently shown, against which the next one is compared to draw only the changes.
+     */
+    std::shared_ptr<const Backend::GameSnapshot> drawnSnapshot;
+
+    /*!
+     * \brief graphPlottables holds the plottables of the branches per function.
+     */
+    std::vector<std::vector<QCPGraph*>> graphPlottables;
+    bool arePreviewGraphsShown;
+
+    /*!
+     * \brief decimationColumnCount is the width of the plot in pixels the graphs shown were decimated for.
+     */
+    int decimationColumnCount;
     QTimer waitTimer;
 
     std::unique_ptr<QMessageBox> waitingMessageBox;
@@ -296,6 +320,12 @@ private:
     size_t numberOfFunctionInputs;
     std::vector<QCPAbstractPlottable*> dotCurves;
 
+    /*!
+     * \brief unitCircleX and unitCircleY hold the outline shared by all dots, scaled and shifted per dot.
+     */
+    QVector<double> unitCircleX;
+    QVector<double> unitCircleY;
+
     std::vector<QColor> graphColors;
     QColor activeGoodDotColor;
     QColor inactiveGoodDotColor;
@@ -341,12 +371,23 @@ private slots:
     void OnWaitTimerFinished();
     void OnWaitingMessageBoxButtonClicked();
     void OnFuncLineEditTextChanged();
+    void OnPlotLayoutUpdated();
 
 private:
     void InitializePlot();
     void SetupColors();
-    void DrawDots();
-    void DrawGraphs();
+    void SetupUnitCircle();
+    void DrawDots(const Backend::GameSnapshot & snapshot);
+    QColor GetDotColor(bool isActive, bool isGood) const;
+    void RecolorDots(const Backend::GameSnapshot & snapshot, const std::vector<size_t> & dotIndices);
+    void DrawGraphs(const Backend::GameSnapshot & snapshot);
+    void DrawGraph(size_t graphIndex, const std::vector<std::pair<std::vector<double>, std::vector<double>>> & graph);
+    void RedrawGraph(const Backend::GameSnapshot & snapshot, size_t graphIndex);
+    void DrawPreviewGraphs();
+    void OnGraphSnapshotPublished(std::shared_ptr<Backend::CancellationToken> cancellationToken,
+                                  unsigned long int graphIndex,
+                                  std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>> snapshot);
+    std::function<void(unsigned long int, std::shared_ptr<const std::vector<std::pair<std::vector<double>, std::vector<double>>>>)> CreateProgressHandler(std::shared_ptr<Backend::CancellationToken> cancellationToken);
     void UpdateWindowTitle();
     void SetGameIsBusy(bool isBusy);
     void UpdateGui();
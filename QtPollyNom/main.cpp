@@ -17,6 +17,8 @@
  */
 
 #include "../Frontend/mainwindow.h"
+#include "../Backend/prefetchingdotgenerator.h"
+#include "../Backend/randomdotgenerator.h"
 
 #include <QApplication>
 #include <QLocale>
@@ -53,7 +55,11 @@ int main(int argc, char *argv[])
 
     a.installTranslator(&translator);
 
-    MainWindow w;
+    // the next board is ready by the time a new game is asked for
+    const size_t boardPrefetchDepth = 1;
+    auto dotGenerator = std::make_shared<Backend::PrefetchingDotGenerator>(std::make_shared<Backend::RandomDotGenerator>(8, 2), boardPrefetchDepth);
+
+    MainWindow w(dotGenerator);
     w.show();
     return a.exec();
 }
@@ -0,0 +1,170 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../Backend/batchgrader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const wchar_t * const Usage =
+            L"usage: QtPollyNomBatch [--format csv|json] [--threads N] [--functions N] <file or directory>...\n"
+            L"  grades saved games, searching directories recursively for *.qpn files,\n"
+            L"  writes one line per game to the standard output and the throughput to the standard error.\n";
+
+    bool TryParseCount(const std::string & argument, unsigned long int & count)
+    {
+        try
+        {
+            size_t parsed = 0;
+            count = std::stoul(argument, &parsed);
+            return parsed == argument.size();
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    void CollectGames(const std::filesystem::path & path, std::vector<std::wstring> & identifiers)
+    {
+        if(!std::filesystem::is_directory(path))
+        {
+            identifiers.push_back(path.wstring());
+            return;
+        }
+
+        std::vector<std::wstring> found;
+        for(const auto & entry : std::filesystem::recursive_directory_iterator(path))
+        {
+            if(entry.is_regular_file() && entry.path().extension() == L".qpn")
+            {
+                found.push_back(entry.path().wstring());
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        identifiers.insert(identifiers.end(), found.begin(), found.end());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool isJson = false;
+    unsigned long int threadCount = 0;
+    unsigned long int functionLimit = Backend::Game::DefaultFunctionLimit;
+    std::vector<std::wstring> identifiers;
+
+    try
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            std::string argument(argv[i]);
+            bool hasValue = i + 1 < argc;
+
+            if(argument == "--format" && hasValue)
+            {
+                std::string format(argv[++i]);
+                if(format != "csv" && format != "json")
+                {
+                    std::wcerr << Usage;
+                    return 1;
+                }
+                isJson = format == "json";
+            }
+            else if(argument == "--threads" && hasValue)
+            {
+                if(!TryParseCount(argv[++i], threadCount))
+                {
+                    std::wcerr << Usage;
+                    return 1;
+                }
+            }
+            else if(argument == "--functions" && hasValue)
+            {
+                if(!TryParseCount(argv[++i], functionLimit) || functionLimit == 0)
+                {
+                    std::wcerr << Usage;
+                    return 1;
+                }
+            }
+            else if(argument.rfind("--", 0) == 0)
+            {
+                std::wcerr << Usage;
+                return 1;
+            }
+            else
+            {
+                CollectGames(std::filesystem::path(argument), identifiers);
+            }
+        }
+    }
+    catch(const std::exception&)
+    {
+        std::wcerr << L"unable to list the games to grade" << std::endl;
+        return 1;
+    }
+
+    if(identifiers.empty())
+    {
+        std::wcerr << Usage;
+        return 1;
+    }
+
+    Backend::BatchGrader grader(std::make_shared<Backend::DiskRepository>(), static_cast<unsigned int>(threadCount), functionLimit);
+
+    if(!isJson)
+    {
+        std::wcout << Backend::BatchGrader::GetCsvHeader() << L'\n';
+    }
+
+    auto consume = [&](const Backend::BatchGrader::Result & result)
+    {
+        std::wcout << (isJson ? Backend::BatchGrader::FormatAsJson(result) : Backend::BatchGrader::FormatAsCsv(result)) << L'\n';
+    };
+
+    // report the throughput about once a second, not after every window of results
+    auto lastReport = std::chrono::steady_clock::now();
+    auto progress = [&](const Backend::BatchGrader::Summary & summary)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if(now - lastReport < std::chrono::seconds(1))
+        {
+            return;
+        }
+
+        lastReport = now;
+        std::wcout.flush();
+        std::wcerr << L"graded " << summary.gradedCount << L" of " << identifiers.size()
+                   << L" games, " << summary.gamesPerSecond << L" per second" << std::endl;
+    };
+
+    auto summary = grader.Grade(identifiers, consume, progress);
+
+    std::wcout.flush();
+    std::wcerr << L"graded " << summary.gradedCount << L" games (" << summary.failedCount << L" failed) on "
+               << grader.GetThreadCount() << L" threads in " << summary.milliseconds / 1000.0 << L" s, "
+               << summary.gamesPerSecond << L" per second" << std::endl;
+
+    return summary.failedCount == 0 ? 0 : 2;
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../Backend/sessionmanager.h"
+
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace
+{
+    const wchar_t * const Usage =
+            L"usage: QtPollyNomServer [--workers N] [--functions N] [--seed N] [--saves DIR]\n"
+            L"  hosts games for many sessions, reading one JSON request per line from the standard input\n"
+            L"  and writing one JSON response per line to the standard output, e.g.\n"
+            L"  {\"id\":1,\"command\":\"create\",\"session\":\"alice\"}\n"
+            L"  {\"id\":2,\"command\":\"update\",\"session\":\"alice\",\"functions\":[\"1/x\"]}\n"
+            L"  a seed makes the sequence of boards handed out reproducible\n"
+            L"  saved games are plain file names inside the save directory, the working directory by default\n";
+
+    bool TryParseCount(const std::string & argument, unsigned long int & count)
+    {
+        try
+        {
+            size_t parsed = 0;
+            count = std::stoul(argument, &parsed);
+            return parsed == argument.size();
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    bool TryParseSeed(const std::string & argument, unsigned long long int & seed)
+    {
+        try
+        {
+            size_t parsed = 0;
+            seed = std::stoull(argument, &parsed);
+            return parsed == argument.size();
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long int workerCount = 0;
+    unsigned long int functionLimit = Backend::Game::DefaultFunctionLimit;
+    std::shared_ptr<Backend::RandomDotGenerator> dotGenerator = std::make_shared<Backend::RandomDotGenerator>(8, 2);
+    std::wstring saveDirectory;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string argument(argv[i]);
+        bool hasValue = i + 1 < argc;
+
+        if(argument == "--workers" && hasValue && TryParseCount(argv[++i], workerCount))
+        {
+            continue;
+        }
+
+        if(argument == "--functions" && hasValue && TryParseCount(argv[++i], functionLimit) && functionLimit > 0)
+        {
+            continue;
+        }
+
+        unsigned long long int seed = 0;
+        if(argument == "--seed" && hasValue && TryParseSeed(argv[++i], seed))
+        {
+            dotGenerator = std::make_shared<Backend::RandomDotGenerator>(Backend::BoardSpec(), seed);
+            continue;
+        }
+
+        if(argument == "--saves" && hasValue && std::filesystem::is_directory(argv[++i]))
+        {
+            saveDirectory = std::filesystem::path(argv[i]).wstring();
+            continue;
+        }
+
+        std::wcerr << Usage;
+        return 1;
+    }
+
+    Backend::SessionManager manager(dotGenerator,
+                                    std::make_shared<Backend::DiskRepository>(saveDirectory),
+                                    static_cast<unsigned int>(workerCount),
+                                    functionLimit);
+
+    // responses arrive on the worker threads
+    std::mutex outputMutex;
+    auto respond = [&](const std::wstring & responseLine)
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::wcout << responseLine << std::endl;
+    };
+
+    std::wstring requestLine;
+    while(std::getline(std::wcin, requestLine))
+    {
+        if(!requestLine.empty())
+        {
+            manager.Submit(requestLine, respond);
+        }
+    }
+
+    manager.WaitUntilIdle();
+
+    return 0;
+}
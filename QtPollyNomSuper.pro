@@ -21,4 +21,6 @@ TEMPLATE = subdirs
 SUBDIRS += \
     BackendTest \
     MainWindowTest \
-    QtPollyNom
+    QtPollyNom \
+    QtPollyNomBatch \
+    QtPollyNomServer
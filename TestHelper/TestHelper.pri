@@ -17,11 +17,15 @@
 #
 
 HEADERS += \
+    $$PWD/countingexpression.h \
     $$PWD/doublehelper.h \
     $$PWD/fixeddotgenerator.h \
+    $$PWD/localsessionclient.h \
     $$PWD/memoryrepository.h
 
 SOURCES += \
+    $$PWD/countingexpression.cpp \
     $$PWD/doublehelper.cpp \
     $$PWD/fixeddotgenerator.cpp \
+    $$PWD/localsessionclient.cpp \
     $$PWD/memoryrepository.cpp
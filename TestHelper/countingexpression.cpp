@@ -0,0 +1,62 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "countingexpression.h"
+
+CountingExpression::CountingExpression(std::shared_ptr<Expression> inner)
+    : Expression(),
+      inner(inner),
+      evaluationCount(0)
+{
+}
+
+int CountingExpression::GetLevel() const
+{
+    return this->inner->GetLevel();
+}
+
+bool CountingExpression::IsMonadic() const
+{
+    return this->inner->IsMonadic();
+}
+
+std::optional<double> CountingExpression::Evaluate(double input) const
+{
+    ++this->evaluationCount;
+    return this->inner->Evaluate(input);
+}
+
+std::optional<std::wstring> CountingExpression::Print() const
+{
+    return this->inner->Print();
+}
+
+bool CountingExpression::operator==(const Expression &other) const
+{
+    return *this->inner == other;
+}
+
+bool CountingExpression::operator!=(const Expression &other) const
+{
+    return *this->inner != other;
+}
+
+unsigned long long CountingExpression::GetEvaluationCount() const
+{
+    return this->evaluationCount;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COUNTINGEXPRESSION_H
+#define COUNTINGEXPRESSION_H
+
+#include "../Backend/expression.h"
+#include <memory>
+
+using namespace Backend;
+
+/*!
+ * \class CountingExpression
+ * \brief The CountingExpression class wraps an expression and counts its evaluations.
+ */
+class CountingExpression final : public Expression
+{
+private:
+    std::shared_ptr<Expression> inner;
+    mutable unsigned long long evaluationCount;
+
+public:
+    /*!
+     * \brief Initializes a new instance wrapping the given expression.
+     * \param inner The expression to forward to.
+     */
+    explicit CountingExpression(std::shared_ptr<Expression> inner);
+
+    /*!
+     * \reimp
+     */
+    virtual int GetLevel() const;
+
+    /*!
+     * \reimp
+     */
+    virtual bool IsMonadic() const;
+
+    /*!
+     * \reimp
+     */
+    virtual std::optional<double> Evaluate(double input) const;
+
+    /*!
+     * \reimp
+     */
+    virtual std::optional<std::wstring> Print() const;
+
+    /*!
+     * \reimp
+     */
+    virtual bool operator==(const Expression &other) const;
+
+    /*!
+     * \reimp
+     */
+    virtual bool operator!=(const Expression &other) const;
+
+    /*!
+     * \brief GetEvaluationCount gets the number of evaluations so far.
+     * \return The number of calls to Evaluate().
+     */
+    unsigned long long GetEvaluationCount() const;
+};
+
+#endif // COUNTINGEXPRESSION_H
@@ -0,0 +1,47 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "localsessionclient.h"
+
+LocalSessionClient::LocalSessionClient(SessionManager & manager)
+    : manager(manager)
+{
+}
+
+rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> LocalSessionClient::Send(const std::wstring & requestLine)
+{
+    auto responseLine = SendAsync(requestLine).get();
+
+    rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> response;
+    response.Parse(responseLine.c_str());
+
+    return response;
+}
+
+std::future<std::wstring> LocalSessionClient::SendAsync(const std::wstring & requestLine)
+{
+    auto promise = std::make_shared<std::promise<std::wstring>>();
+    auto future = promise->get_future();
+
+    manager.Submit(requestLine, [promise](const std::wstring & responseLine)
+    {
+        promise->set_value(responseLine);
+    });
+
+    return future;
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of QtPollyNom.
+ *
+ * QtPollyNom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtPollyNom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtPollyNom.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LOCALSESSIONCLIENT_H
+#define LOCALSESSIONCLIENT_H
+
+#include "../Backend/sessionmanager.h"
+#include <future>
+#include <string>
+
+using namespace Backend;
+
+/*!
+ * \class LocalSessionClient
+ * \brief The LocalSessionClient class stands in for a remote client, driving a session manager in-process.
+ */
+class LocalSessionClient final
+{
+private:
+    SessionManager & manager;
+
+public:
+    /*!
+     * \brief Initializes a new instance.
+     * \param manager The manager to send the requests to.
+     */
+    explicit LocalSessionClient(SessionManager & manager);
+
+    /*!
+     * \brief Send sends a request and waits for its response.
+     * \param requestLine The request as a single-line JSON object.
+     * \return The response as a parsed document.
+     */
+    rapidjson::GenericDocument<rapidjson::UTF16<wchar_t>> Send(const std::wstring & requestLine);
+
+    /*!
+     * \brief SendAsync sends a request without waiting for its response.
+     * \param requestLine The request as a single-line JSON object.
+     * \return The future response line.
+     */
+    std::future<std::wstring> SendAsync(const std::wstring & requestLine);
+};
+
+#endif // LOCALSESSIONCLIENT_H